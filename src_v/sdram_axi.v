@@ -33,10 +33,48 @@
 //-----------------------------------------------------------------
 
 module sdram_axi
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter SDRAM_MHZ           = 50
+    ,parameter SDRAM_ADDR_W        = 24
+    ,parameter SDRAM_COL_W         = 9
+    ,parameter SDRAM_BANK_W        = 2
+    ,parameter SDRAM_RANK_W        = 0
+    ,parameter SDRAM_READ_LATENCY  = 2
+    ,parameter SDRAM_TRCD_NS       = 20
+    ,parameter SDRAM_TRP_NS        = 20
+    ,parameter SDRAM_TRFC_NS       = 60
+    ,parameter SDRAM_TWR_NS        = 15
+    ,parameter SDRAM_TRAS_NS       = 44
+    ,parameter SDRAM_TRRD_NS       = 15
+    ,parameter SDRAM_CAS_LATENCY   = 2
+    ,parameter SDRAM_PIPELINE      = 0
+    ,parameter SDRAM_READ_CAL      = 0
+    ,parameter SDRAM_CAPTURE_FLOPS = 2
+    ,parameter SDRAM_PREACTIVATE   = 0
+    ,parameter AXI_READ_REORDER    = 0
+    ,parameter AXI_REQ_DEPTH       = 4
+    ,parameter AXI_RESP_DEPTH      = 4
+    ,parameter AXI_WDATA_DEPTH     = 0
+    ,parameter STREAM_DEPTH        = 512
+    ,parameter STREAM_WATERMARK    = 256
+    ,parameter STREAM_OUTSTANDING  = 8
+    ,parameter XFER_BUF_DEPTH      = 256
+    ,parameter XFER_OUTSTANDING    = 8
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
 (
     // Inputs
      input           clk_i
     ,input           rst_i
+`ifdef SDRAM_AXI_ASYNC
+    ,input           sdram_clk_i
+    ,input           sdram_rst_i
+`endif
     ,input           inport_awvalid_i
     ,input  [ 31:0]  inport_awaddr_i
     ,input  [  3:0]  inport_awid_i
@@ -54,6 +92,20 @@ module sdram_axi
     ,input  [  1:0]  inport_arburst_i
     ,input           inport_rready_i
     ,input  [ 15:0]  sdram_data_input_i
+`ifdef SDRAM_AXI_STREAM
+    ,input           stream_start_i
+    ,input  [ 31:0]  stream_addr_i
+    ,input  [ 31:0]  stream_len_i
+    ,input           stream_ready_i
+`endif
+`ifdef SDRAM_AXI_XFER
+    ,input           xfer_start_i
+    ,input           xfer_copy_i
+    ,input  [ 31:0]  xfer_src_i
+    ,input  [ 31:0]  xfer_dst_i
+    ,input  [ 31:0]  xfer_len_i
+    ,input  [ 31:0]  xfer_fill_data_i
+`endif
 
     // Outputs
     ,output          inport_awready_o
@@ -69,27 +121,28 @@ module sdram_axi
     ,output          inport_rlast_o
     ,output          sdram_clk_o
     ,output          sdram_cke_o
-    ,output          sdram_cs_o
+    ,output [(1<<SDRAM_RANK_W)-1:0] sdram_cs_o
     ,output          sdram_ras_o
     ,output          sdram_cas_o
     ,output          sdram_we_o
     ,output [  1:0]  sdram_dqm_o
     ,output [ 12:0]  sdram_addr_o
-    ,output [  1:0]  sdram_ba_o
+    ,output [SDRAM_BANK_W-1:0] sdram_ba_o
     ,output [ 15:0]  sdram_data_output_o
     ,output          sdram_data_out_en_o
+`ifdef SDRAM_AXI_STREAM
+    ,output          stream_valid_o
+    ,output [ 31:0]  stream_data_o
+    ,output          stream_busy_o
+`endif
+`ifdef SDRAM_AXI_XFER
+    ,output          xfer_busy_o
+    ,output          xfer_done_o
+`endif
 );
 
 
 
-//-----------------------------------------------------------------
-// Key Params
-//-----------------------------------------------------------------
-parameter SDRAM_MHZ             = 50;
-parameter SDRAM_ADDR_W          = 24;
-parameter SDRAM_COL_W           = 9;
-parameter SDRAM_READ_LATENCY    = 2;
-
 //-----------------------------------------------------------------
 // AXI Interface
 //-----------------------------------------------------------------
@@ -103,7 +156,37 @@ wire [  7:0]  ram_len_w;
 wire          ram_ack_w;
 wire          ram_error_w;
 
+wire [ 31:0]  pmem_addr_w;
+wire [  3:0]  pmem_wr_w;
+wire          pmem_rd_w;
+wire          pmem_accept_w;
+wire [ 31:0]  pmem_write_data_w;
+wire [ 31:0]  pmem_read_data_w;
+wire [  7:0]  pmem_len_w;
+wire          pmem_ack_w;
+wire          pmem_error_w;
+
+wire [ 31:0]  xfer_addr_w;
+wire [  3:0]  xfer_wr_w;
+wire          xfer_rd_w;
+wire          xfer_accept_w;
+wire [ 31:0]  xfer_write_data_w;
+wire [ 31:0]  xfer_read_data_w;
+wire [  7:0]  xfer_len_w;
+wire          xfer_ack_w;
+wire          xfer_error_w;
+
 sdram_axi_pmem
+#(
+     .AXI_READ_REORDER(AXI_READ_REORDER)
+    ,.SDRAM_ADDR_W(SDRAM_ADDR_W)
+    ,.SDRAM_COL_W(SDRAM_COL_W)
+    ,.SDRAM_BANK_W(SDRAM_BANK_W)
+    ,.SDRAM_RANK_W(SDRAM_RANK_W)
+    ,.AXI_REQ_DEPTH(AXI_REQ_DEPTH)
+    ,.AXI_RESP_DEPTH(AXI_RESP_DEPTH)
+    ,.AXI_WDATA_DEPTH(AXI_WDATA_DEPTH)
+)
 u_axi
 (
     .clk_i(clk_i),
@@ -139,17 +222,234 @@ u_axi
     .axi_rlast_o(inport_rlast_o),
     
     // RAM interface
-    .ram_addr_o(ram_addr_w),
-    .ram_accept_i(ram_accept_w),
-    .ram_wr_o(ram_wr_w),
-    .ram_rd_o(ram_rd_w),
-    .ram_len_o(ram_len_w),
-    .ram_write_data_o(ram_write_data_w),
-    .ram_ack_i(ram_ack_w),
-    .ram_error_i(ram_error_w),
-    .ram_read_data_i(ram_read_data_w)
+    .ram_addr_o(pmem_addr_w),
+    .ram_accept_i(pmem_accept_w),
+    .ram_wr_o(pmem_wr_w),
+    .ram_rd_o(pmem_rd_w),
+    .ram_len_o(pmem_len_w),
+    .ram_write_data_o(pmem_write_data_w),
+    .ram_ack_i(pmem_ack_w),
+    .ram_error_i(pmem_error_w),
+    .ram_read_data_i(pmem_read_data_w)
 );
 
+//-----------------------------------------------------------------
+// Streaming read port
+//-----------------------------------------------------------------
+`ifdef SDRAM_AXI_STREAM
+// SDRAM_AXI_STREAM: prefetching read port with priority below a
+// FIFO watermark (e.g. display refresh), see sdram_axi_stream.v
+sdram_axi_stream
+#(
+     .SDRAM_COL_W(SDRAM_COL_W)
+    ,.STREAM_DEPTH(STREAM_DEPTH)
+    ,.STREAM_WATERMARK(STREAM_WATERMARK)
+    ,.STREAM_OUTSTANDING(STREAM_OUTSTANDING)
+    ,.AXI_RESP_DEPTH(AXI_RESP_DEPTH)
+)
+u_stream
+(
+     .clk_i(clk_i)
+    ,.rst_i(rst_i)
+
+    ,.stream_start_i(stream_start_i)
+    ,.stream_addr_i(stream_addr_i)
+    ,.stream_len_i(stream_len_i)
+    ,.stream_ready_i(stream_ready_i)
+    ,.stream_valid_o(stream_valid_o)
+    ,.stream_data_o(stream_data_o)
+    ,.stream_busy_o(stream_busy_o)
+
+    ,.inport_wr_i(pmem_wr_w)
+    ,.inport_rd_i(pmem_rd_w)
+    ,.inport_len_i(pmem_len_w)
+    ,.inport_addr_i(pmem_addr_w)
+    ,.inport_write_data_i(pmem_write_data_w)
+    ,.inport_accept_o(pmem_accept_w)
+    ,.inport_ack_o(pmem_ack_w)
+    ,.inport_error_o(pmem_error_w)
+    ,.inport_read_data_o(pmem_read_data_w)
+
+    ,.outport_wr_o(xfer_wr_w)
+    ,.outport_rd_o(xfer_rd_w)
+    ,.outport_len_o(xfer_len_w)
+    ,.outport_addr_o(xfer_addr_w)
+    ,.outport_write_data_o(xfer_write_data_w)
+    ,.outport_accept_i(xfer_accept_w)
+    ,.outport_ack_i(xfer_ack_w)
+    ,.outport_error_i(xfer_error_w)
+    ,.outport_read_data_i(xfer_read_data_w)
+);
+
+localparam XFER_INPORT_OUTSTANDING = AXI_RESP_DEPTH + STREAM_OUTSTANDING;
+`else
+assign xfer_addr_w       = pmem_addr_w;
+assign xfer_wr_w         = pmem_wr_w;
+assign xfer_rd_w         = pmem_rd_w;
+assign xfer_len_w        = pmem_len_w;
+assign xfer_write_data_w = pmem_write_data_w;
+assign pmem_accept_w     = xfer_accept_w;
+assign pmem_ack_w        = xfer_ack_w;
+assign pmem_error_w      = xfer_error_w;
+assign pmem_read_data_w  = xfer_read_data_w;
+
+localparam XFER_INPORT_OUTSTANDING = AXI_RESP_DEPTH;
+`endif
+
+//-----------------------------------------------------------------
+// Fill / copy engine
+//-----------------------------------------------------------------
+`ifdef SDRAM_AXI_XFER
+// SDRAM_AXI_XFER: row batched bulk fill / copy without AXI traffic,
+// see sdram_axi_xfer.v
+sdram_axi_xfer
+#(
+     .SDRAM_COL_W(SDRAM_COL_W)
+    ,.XFER_BUF_DEPTH(XFER_BUF_DEPTH)
+    ,.XFER_OUTSTANDING(XFER_OUTSTANDING)
+    ,.INPORT_OUTSTANDING(XFER_INPORT_OUTSTANDING)
+)
+u_xfer
+(
+     .clk_i(clk_i)
+    ,.rst_i(rst_i)
+
+    ,.xfer_start_i(xfer_start_i)
+    ,.xfer_copy_i(xfer_copy_i)
+    ,.xfer_src_i(xfer_src_i)
+    ,.xfer_dst_i(xfer_dst_i)
+    ,.xfer_len_i(xfer_len_i)
+    ,.xfer_fill_data_i(xfer_fill_data_i)
+    ,.xfer_busy_o(xfer_busy_o)
+    ,.xfer_done_o(xfer_done_o)
+
+    ,.inport_wr_i(xfer_wr_w)
+    ,.inport_rd_i(xfer_rd_w)
+    ,.inport_len_i(xfer_len_w)
+    ,.inport_addr_i(xfer_addr_w)
+    ,.inport_write_data_i(xfer_write_data_w)
+    ,.inport_accept_o(xfer_accept_w)
+    ,.inport_ack_o(xfer_ack_w)
+    ,.inport_error_o(xfer_error_w)
+    ,.inport_read_data_o(xfer_read_data_w)
+
+    ,.outport_wr_o(ram_wr_w)
+    ,.outport_rd_o(ram_rd_w)
+    ,.outport_len_o(ram_len_w)
+    ,.outport_addr_o(ram_addr_w)
+    ,.outport_write_data_o(ram_write_data_w)
+    ,.outport_accept_i(ram_accept_w)
+    ,.outport_ack_i(ram_ack_w)
+    ,.outport_error_i(ram_error_w)
+    ,.outport_read_data_i(ram_read_data_w)
+);
+
+localparam RAM_OUTSTANDING = XFER_INPORT_OUTSTANDING + XFER_OUTSTANDING;
+`else
+assign ram_addr_w        = xfer_addr_w;
+assign ram_wr_w          = xfer_wr_w;
+assign ram_rd_w          = xfer_rd_w;
+assign ram_len_w         = xfer_len_w;
+assign ram_write_data_w  = xfer_write_data_w;
+assign xfer_accept_w     = ram_accept_w;
+assign xfer_ack_w        = ram_ack_w;
+assign xfer_error_w      = ram_error_w;
+assign xfer_read_data_w  = ram_read_data_w;
+
+localparam RAM_OUTSTANDING = XFER_INPORT_OUTSTANDING;
+`endif
+
+//-----------------------------------------------------------------
+// Clock domain crossing
+//-----------------------------------------------------------------
+wire          core_clk_w;
+wire          core_rst_w;
+wire [ 31:0]  core_addr_w;
+wire [  3:0]  core_wr_w;
+wire          core_rd_w;
+wire          core_accept_w;
+wire [ 31:0]  core_write_data_w;
+wire [ 31:0]  core_read_data_w;
+wire [  7:0]  core_len_w;
+wire          core_ack_w;
+wire          core_error_w;
+
+`ifdef SDRAM_AXI_ASYNC
+// SDRAM_AXI_ASYNC: AXI on clk_i, SDRAM (and SDRAM_MHZ) on sdram_clk_i.
+// Requests cross through u_req_cdc, responses through u_resp_cdc which
+// cannot overflow as it holds every beat that can be in flight:
+// sdram_axi_pmem's response credits plus the stream port's and the
+// fill / copy engine's outstanding reads and writes (RAM_OUTSTANDING).
+localparam CDC_DEPTH  = (RAM_OUTSTANDING < 4) ? 4 : (2 ** $clog2(RAM_OUTSTANDING));
+localparam CDC_ADDR_W = $clog2(CDC_DEPTH);
+
+wire          core_req_valid_w;
+wire [  3:0]  core_req_wr_w;
+wire          core_req_rd_w;
+
+assign core_clk_w = sdram_clk_i;
+assign core_rst_w = sdram_rst_i;
+
+sdram_axi_async_fifo
+#(
+     .WIDTH(4 + 1 + 8 + 32 + 32)
+    ,.DEPTH(CDC_DEPTH)
+    ,.ADDR_W(CDC_ADDR_W)
+)
+u_req_cdc
+(
+     .wr_clk_i(clk_i)
+    ,.wr_rst_i(rst_i)
+    ,.wr_data_i({ram_wr_w, ram_rd_w, ram_len_w, ram_addr_w, ram_write_data_w})
+    ,.wr_push_i(ram_rd_w || (ram_wr_w != 4'b0))
+    ,.wr_accept_o(ram_accept_w)
+
+    ,.rd_clk_i(sdram_clk_i)
+    ,.rd_rst_i(sdram_rst_i)
+    ,.rd_pop_i(core_accept_w)
+    ,.rd_data_o({core_req_wr_w, core_req_rd_w, core_len_w, core_addr_w, core_write_data_w})
+    ,.rd_valid_o(core_req_valid_w)
+);
+
+assign core_wr_w = core_req_valid_w ? core_req_wr_w : 4'b0;
+assign core_rd_w = core_req_valid_w & core_req_rd_w;
+
+sdram_axi_async_fifo
+#(
+     .WIDTH(32)
+    ,.DEPTH(CDC_DEPTH)
+    ,.ADDR_W(CDC_ADDR_W)
+)
+u_resp_cdc
+(
+     .wr_clk_i(sdram_clk_i)
+    ,.wr_rst_i(sdram_rst_i)
+    ,.wr_data_i(core_read_data_w)
+    ,.wr_push_i(core_ack_w)
+    ,.wr_accept_o()
+
+    ,.rd_clk_i(clk_i)
+    ,.rd_rst_i(rst_i)
+    ,.rd_pop_i(1'b1)
+    ,.rd_data_o(ram_read_data_w)
+    ,.rd_valid_o(ram_ack_w)
+);
+
+assign ram_error_w = 1'b0;
+`else
+assign core_clk_w        = clk_i;
+assign core_rst_w        = rst_i;
+assign core_addr_w       = ram_addr_w;
+assign core_wr_w         = ram_wr_w;
+assign core_rd_w         = ram_rd_w;
+assign core_len_w        = ram_len_w;
+assign core_write_data_w = ram_write_data_w;
+assign ram_accept_w      = core_accept_w;
+assign ram_ack_w         = core_ack_w;
+assign ram_error_w       = core_error_w;
+assign ram_read_data_w   = core_read_data_w;
+`endif
+
 //-----------------------------------------------------------------
 // SDRAM Controller
 //-----------------------------------------------------------------
@@ -158,22 +458,35 @@ sdram_axi_core
      .SDRAM_MHZ(SDRAM_MHZ)
     ,.SDRAM_ADDR_W(SDRAM_ADDR_W)
     ,.SDRAM_COL_W(SDRAM_COL_W)
+    ,.SDRAM_BANK_W(SDRAM_BANK_W)
+    ,.SDRAM_RANK_W(SDRAM_RANK_W)
     ,.SDRAM_READ_LATENCY(SDRAM_READ_LATENCY)
+    ,.SDRAM_TRCD_NS(SDRAM_TRCD_NS)
+    ,.SDRAM_TRP_NS(SDRAM_TRP_NS)
+    ,.SDRAM_TRFC_NS(SDRAM_TRFC_NS)
+    ,.SDRAM_TWR_NS(SDRAM_TWR_NS)
+    ,.SDRAM_TRAS_NS(SDRAM_TRAS_NS)
+    ,.SDRAM_TRRD_NS(SDRAM_TRRD_NS)
+    ,.SDRAM_CAS_LATENCY(SDRAM_CAS_LATENCY)
+    ,.SDRAM_PIPELINE(SDRAM_PIPELINE)
+    ,.SDRAM_READ_CAL(SDRAM_READ_CAL)
+    ,.SDRAM_CAPTURE_FLOPS(SDRAM_CAPTURE_FLOPS)
+    ,.SDRAM_PREACTIVATE(SDRAM_PREACTIVATE)
 )
 u_core
 (
-     .clk_i(clk_i)
-    ,.rst_i(rst_i)
+     .clk_i(core_clk_w)
+    ,.rst_i(core_rst_w)
 
-    ,.inport_wr_i(ram_wr_w)
-    ,.inport_rd_i(ram_rd_w)
-    ,.inport_len_i(ram_len_w)
-    ,.inport_addr_i(ram_addr_w)
-    ,.inport_write_data_i(ram_write_data_w)
-    ,.inport_accept_o(ram_accept_w)
-    ,.inport_ack_o(ram_ack_w)
-    ,.inport_error_o(ram_error_w)
-    ,.inport_read_data_o(ram_read_data_w)
+    ,.inport_wr_i(core_wr_w)
+    ,.inport_rd_i(core_rd_w)
+    ,.inport_len_i(core_len_w)
+    ,.inport_addr_i(core_addr_w)
+    ,.inport_write_data_i(core_write_data_w)
+    ,.inport_accept_o(core_accept_w)
+    ,.inport_ack_o(core_ack_w)
+    ,.inport_error_o(core_error_w)
+    ,.inport_read_data_o(core_read_data_w)
 
     ,.sdram_clk_o(sdram_clk_o)
     ,.sdram_cke_o(sdram_cke_o)
@@ -0,0 +1,162 @@
+//-----------------------------------------------------------------
+//                    SDRAM Controller (AXI4)
+//
+//                         License: GPL
+//-----------------------------------------------------------------
+//
+// This file is open source HDL; you can redistribute it and/or 
+// modify it under the terms of the GNU General Public License as 
+// published by the Free Software Foundation; either version 2 of 
+// the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public 
+// License along with this file; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+//-----------------------------------------------------------------
+
+//-----------------------------------------------------------------
+// Dual clock FIFO (gray coded pointers, 2 flop synchronisers)
+//-----------------------------------------------------------------
+module sdram_axi_async_fifo
+
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+    parameter WIDTH   = 8,
+    parameter DEPTH   = 4,
+    parameter ADDR_W  = 2
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
+(
+    // Write side
+     input               wr_clk_i
+    ,input               wr_rst_i
+    ,input  [WIDTH-1:0]  wr_data_i
+    ,input               wr_push_i
+    ,output              wr_accept_o
+
+    // Read side
+    ,input               rd_clk_i
+    ,input               rd_rst_i
+    ,input               rd_pop_i
+    ,output [WIDTH-1:0]  rd_data_o
+    ,output              rd_valid_o
+);
+
+// Gray coded pointers wrap at 2^ADDR_W: DEPTH must be that power of 2
+generate
+if (DEPTH < 2 || DEPTH != (2 ** ADDR_W))
+begin : g_depth_check
+    sdram_axi_fifo_depth_not_power_of_2 u_error_depth();
+end
+endgenerate
+
+//-----------------------------------------------------------------
+// Gray code conversion
+//-----------------------------------------------------------------
+function [ADDR_W:0] bin2gray;
+    input [ADDR_W:0] bin;
+begin
+    bin2gray = bin ^ (bin >> 1);
+end
+endfunction
+
+function [ADDR_W:0] gray2bin;
+    input [ADDR_W:0] gray;
+    integer          i;
+begin
+    gray2bin[ADDR_W] = gray[ADDR_W];
+    for (i=ADDR_W-1;i>=0;i=i-1)
+        gray2bin[i] = gray2bin[i+1] ^ gray[i];
+end
+endfunction
+
+//-----------------------------------------------------------------
+// Registers
+//-----------------------------------------------------------------
+reg [WIDTH-1:0]   ram [DEPTH-1:0];
+
+// Pointers carry an extra wrap bit (full / empty)
+reg [ADDR_W:0]    wr_ptr_q;
+reg [ADDR_W:0]    wr_gray_q;
+reg [ADDR_W:0]    rd_ptr_q;
+reg [ADDR_W:0]    rd_gray_q;
+
+// Opposite domain's pointer, synchronised
+reg [ADDR_W:0]    rd_gray_sync0_q;
+reg [ADDR_W:0]    rd_gray_sync1_q;
+reg [ADDR_W:0]    wr_gray_sync0_q;
+reg [ADDR_W:0]    wr_gray_sync1_q;
+
+//-----------------------------------------------------------------
+// Write domain
+//-----------------------------------------------------------------
+wire [ADDR_W:0] wr_rd_ptr_w = gray2bin(rd_gray_sync1_q);
+wire [ADDR_W:0] wr_next_w   = wr_ptr_q + 1'b1;
+
+assign wr_accept_o = !((wr_ptr_q[ADDR_W] != wr_rd_ptr_w[ADDR_W]) &&
+                       (wr_ptr_q[ADDR_W-1:0] == wr_rd_ptr_w[ADDR_W-1:0]));
+
+always @ (posedge wr_clk_i or posedge wr_rst_i)
+if (wr_rst_i)
+begin
+    wr_ptr_q        <= {(ADDR_W+1) {1'b0}};
+    wr_gray_q       <= {(ADDR_W+1) {1'b0}};
+    rd_gray_sync0_q <= {(ADDR_W+1) {1'b0}};
+    rd_gray_sync1_q <= {(ADDR_W+1) {1'b0}};
+end
+else
+begin
+    if (wr_push_i && wr_accept_o)
+    begin
+        wr_ptr_q    <= wr_next_w;
+        wr_gray_q   <= bin2gray(wr_next_w);
+    end
+
+    rd_gray_sync0_q <= rd_gray_q;
+    rd_gray_sync1_q <= rd_gray_sync0_q;
+end
+
+always @ (posedge wr_clk_i)
+if (wr_push_i && wr_accept_o)
+    ram[wr_ptr_q[ADDR_W-1:0]] <= wr_data_i;
+
+//-----------------------------------------------------------------
+// Read domain
+//-----------------------------------------------------------------
+wire [ADDR_W:0] rd_wr_ptr_w = gray2bin(wr_gray_sync1_q);
+wire [ADDR_W:0] rd_next_w   = rd_ptr_q + 1'b1;
+
+assign rd_valid_o = (rd_ptr_q != rd_wr_ptr_w);
+assign rd_data_o  = ram[rd_ptr_q[ADDR_W-1:0]];
+
+always @ (posedge rd_clk_i or posedge rd_rst_i)
+if (rd_rst_i)
+begin
+    rd_ptr_q        <= {(ADDR_W+1) {1'b0}};
+    rd_gray_q       <= {(ADDR_W+1) {1'b0}};
+    wr_gray_sync0_q <= {(ADDR_W+1) {1'b0}};
+    wr_gray_sync1_q <= {(ADDR_W+1) {1'b0}};
+end
+else
+begin
+    if (rd_pop_i && rd_valid_o)
+    begin
+        rd_ptr_q    <= rd_next_w;
+        rd_gray_q   <= bin2gray(rd_next_w);
+    end
+
+    wr_gray_sync0_q <= wr_gray_q;
+    wr_gray_sync1_q <= wr_gray_sync0_q;
+end
+
+endmodule
@@ -33,6 +33,31 @@
 //-----------------------------------------------------------------
 
 module sdram_axi_core
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter SDRAM_MHZ           = 50
+    ,parameter SDRAM_ADDR_W        = 24
+    ,parameter SDRAM_COL_W         = 9
+    ,parameter SDRAM_BANK_W        = 2
+    ,parameter SDRAM_RANK_W        = 0
+    ,parameter SDRAM_READ_LATENCY  = 2
+    ,parameter SDRAM_TRCD_NS       = 20
+    ,parameter SDRAM_TRP_NS        = 20
+    ,parameter SDRAM_TRFC_NS       = 60
+    ,parameter SDRAM_TWR_NS        = 15
+    ,parameter SDRAM_TRAS_NS       = 44
+    ,parameter SDRAM_TRRD_NS       = 15
+    ,parameter SDRAM_CAS_LATENCY   = 2
+    ,parameter SDRAM_PIPELINE      = 0
+    ,parameter SDRAM_READ_CAL      = 0
+    ,parameter SDRAM_CAPTURE_FLOPS = 2
+    ,parameter SDRAM_PREACTIVATE   = 0
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
 (
     // Inputs
      input           clk_i
@@ -51,36 +76,60 @@ module sdram_axi_core
     ,output [ 31:0]  inport_read_data_o
     ,output          sdram_clk_o
     ,output          sdram_cke_o
-    ,output          sdram_cs_o
+    ,output [(1<<SDRAM_RANK_W)-1:0] sdram_cs_o
     ,output          sdram_ras_o
     ,output          sdram_cas_o
     ,output          sdram_we_o
     ,output [  1:0]  sdram_dqm_o
     ,output [ 12:0]  sdram_addr_o
-    ,output [  1:0]  sdram_ba_o
+    ,output [SDRAM_BANK_W-1:0] sdram_ba_o
     ,output [ 15:0]  sdram_data_output_o
     ,output          sdram_data_out_en_o
 );
 
 
 
-//-----------------------------------------------------------------
-// Key Params
-//-----------------------------------------------------------------
-parameter SDRAM_MHZ              = 50;
-parameter SDRAM_ADDR_W           = 24;
-parameter SDRAM_COL_W            = 9;
-parameter SDRAM_READ_LATENCY     = 2;
-
 //-----------------------------------------------------------------
 // Defines / Local params
 //-----------------------------------------------------------------
-localparam SDRAM_BANK_W          = 2;
+// Banks are tracked across all ranks (chip selects), indexed by
+// {rank, bank}, which sit between the column and row address bits.
 localparam SDRAM_DQM_W           = 2;
-localparam SDRAM_BANKS           = 2 ** SDRAM_BANK_W;
+localparam SDRAM_RANKS           = 2 ** SDRAM_RANK_W;
+localparam SDRAM_SLOT_W          = SDRAM_RANK_W + SDRAM_BANK_W;
+localparam SDRAM_BANKS           = 2 ** SDRAM_SLOT_W;
 localparam SDRAM_ROW_W           = SDRAM_ADDR_W - SDRAM_COL_W - SDRAM_BANK_W;
 localparam SDRAM_REFRESH_CNT     = 2 ** SDRAM_ROW_W;
+
+// Rows drive A0..A12 (A10 doubles as auto precharge / all banks), so
+// the geometry must give 11 to 13 row bits
+generate
+if (SDRAM_ROW_W > 13 || SDRAM_ROW_W < 11)
+begin : g_row_w_check
+    sdram_row_w_not_supported u_error_row_w();
+end
+endgenerate
+
+// At most 16 banks tracked across all ranks (e.g. 2 ranks of 8 banks or
+// 4 ranks of 4 banks)
+generate
+if (SDRAM_SLOT_W > 4)
+begin : g_slot_w_check
+    sdram_rank_bank_w_not_supported u_error_slot_w();
+end
+endgenerate
+`ifdef SDRAM_FAST_INIT
+`ifdef verilator
+// Simulation only: skip the 100uS power-up wait
+localparam SDRAM_START_DELAY     = 0;
+`else
+// SDRAM_FAST_INIT is not permitted outside of Verilator simulation
+sdram_fast_init_simulation_only u_error();
+localparam SDRAM_START_DELAY     = 100000 / (1000 / SDRAM_MHZ); // 100uS
+`endif
+`else
 localparam SDRAM_START_DELAY     = 100000 / (1000 / SDRAM_MHZ); // 100uS
+`endif
 localparam SDRAM_REFRESH_CYCLES  = (64000*SDRAM_MHZ) / SDRAM_REFRESH_CNT-1;
 
 localparam CMD_W             = 4;
@@ -93,8 +142,9 @@ localparam CMD_PRECHARGE     = 4'b0010;
 localparam CMD_REFRESH       = 4'b0001;
 localparam CMD_LOAD_MODE     = 4'b0000;
 
-// Mode: Burst Length = 4 bytes, CAS=2
-localparam MODE_REG          = {3'b000,1'b0,2'b00,3'b010,1'b0,3'b001};
+// Mode: Burst Length = 4 bytes, CAS=SDRAM_CAS_LATENCY (2 or 3)
+localparam [2:0] MODE_CAS    = SDRAM_CAS_LATENCY;
+localparam MODE_REG          = {3'b000,1'b0,2'b00,MODE_CAS,1'b0,3'b001};
 
 // SM states
 localparam STATE_W           = 4;
@@ -108,6 +158,7 @@ localparam STATE_WRITE0      = 4'd6;
 localparam STATE_WRITE1      = 4'd7;
 localparam STATE_PRECHARGE   = 4'd8;
 localparam STATE_REFRESH     = 4'd9;
+localparam STATE_PREACT      = 4'd10;
 
 localparam AUTO_PRECHARGE    = 10;
 localparam ALL_BANKS         = 10;
@@ -117,27 +168,90 @@ localparam SDRAM_DATA_W      = 16;
 localparam CYCLE_TIME_NS     = 1000 / SDRAM_MHZ;
 
 // SDRAM timing
-localparam SDRAM_TRCD_CYCLES = (20 + (CYCLE_TIME_NS-1)) / CYCLE_TIME_NS;
-localparam SDRAM_TRP_CYCLES  = (20 + (CYCLE_TIME_NS-1)) / CYCLE_TIME_NS;
-localparam SDRAM_TRFC_CYCLES = (60 + (CYCLE_TIME_NS-1)) / CYCLE_TIME_NS;
+localparam SDRAM_TRCD_CYCLES = (SDRAM_TRCD_NS + (CYCLE_TIME_NS-1)) / CYCLE_TIME_NS;
+localparam SDRAM_TRP_CYCLES  = (SDRAM_TRP_NS + (CYCLE_TIME_NS-1)) / CYCLE_TIME_NS;
+localparam SDRAM_TRFC_CYCLES = (SDRAM_TRFC_NS + (CYCLE_TIME_NS-1)) / CYCLE_TIME_NS;
+localparam SDRAM_TWR_CYCLES  = (SDRAM_TWR_NS + (CYCLE_TIME_NS-1)) / CYCLE_TIME_NS;
+localparam SDRAM_TRAS_CYCLES = (SDRAM_TRAS_NS + (CYCLE_TIME_NS-1)) / CYCLE_TIME_NS;
+localparam SDRAM_TRRD_CYCLES = (SDRAM_TRRD_NS + (CYCLE_TIME_NS-1)) / CYCLE_TIME_NS;
+
+// Last write data to PRECHARGE is 2 cycles via IDLE, wait out the rest
+// of tWR in WRITE1 (only needed above 100MHz)
+localparam SDRAM_TWR_EXTRA   = (SDRAM_TWR_CYCLES > 2) ? (SDRAM_TWR_CYCLES - 2) : 0;
+
+localparam SDRAM_ROW_WORDS   = 2 ** (SDRAM_COL_W - 1);
+
+// Read latency calibration: last word of the SDRAM (halves differ so an
+// early or late capture can never match)
+localparam [31:0] CAL_ADDR    = (32'd2 << (SDRAM_ADDR_W + SDRAM_RANK_W)) - 32'd4;
+localparam [31:0] CAL_PATTERN = 32'hA5C35A3C;
+
+localparam CAL_W             = 2;
+localparam CAL_WRITE         = 2'd0;
+localparam CAL_READ          = 2'd1;
+localparam CAL_WAIT          = 2'd2;
+localparam CAL_DONE          = 2'd3;
 
 //-----------------------------------------------------------------
 // External Interface
 //-----------------------------------------------------------------
-wire [ 31:0]  ram_addr_w       = inport_addr_i;
-wire [  3:0]  ram_wr_w         = inport_wr_i;
-wire          ram_rd_w         = inport_rd_i;
+// SDRAM_PIPELINE=1: requests are registered on entry (with the row
+// hit/miss lookup, see below) so the state machine only sees flops.
+// The stage reloads in the cycle its request is accepted, so row hits
+// still stream back to back.
+reg  [ 31:0]  in_addr_q;
+reg  [  3:0]  in_wr_q;
+reg           in_rd_q;
+reg  [ 31:0]  in_write_data_q;
+
+// SDRAM_READ_CAL=1: the calibration sequence owns the request port
+// until the read latency has been found.
+reg [CAL_W-1:0] cal_state_q;
+reg [3:0]       rd_lat_q;
+wire            cal_busy_w = (cal_state_q != CAL_DONE);
+
+wire [ 31:0]  req_addr_w       = (SDRAM_PIPELINE != 0) ? in_addr_q       : inport_addr_i;
+wire [  3:0]  req_wr_w         = (SDRAM_PIPELINE != 0) ? in_wr_q         : inport_wr_i;
+wire          req_rd_w         = (SDRAM_PIPELINE != 0) ? in_rd_q         : inport_rd_i;
+wire [ 31:0]  req_write_data_w = (SDRAM_PIPELINE != 0) ? in_write_data_q : inport_write_data_i;
+
+wire [ 31:0]  ram_addr_w       = cal_busy_w ? CAL_ADDR : req_addr_w;
+wire [  3:0]  ram_wr_w         = cal_busy_w ? {4{cal_state_q == CAL_WRITE}} : req_wr_w;
+wire          ram_rd_w         = cal_busy_w ? (cal_state_q == CAL_READ) : req_rd_w;
 wire          ram_accept_w;
-wire [ 31:0]  ram_write_data_w = inport_write_data_i;
+wire [ 31:0]  ram_write_data_w = cal_busy_w ? CAL_PATTERN : req_write_data_w;
 wire [ 31:0]  ram_read_data_w;
 wire          ram_ack_w;
 
 wire          ram_req_w = (ram_wr_w != 4'b0) | ram_rd_w;
 
-assign inport_ack_o       = ram_ack_w;
+assign inport_ack_o       = ram_ack_w && !cal_busy_w;
 assign inport_read_data_o = ram_read_data_w;
 assign inport_error_o     = 1'b0;
-assign inport_accept_o    = ram_accept_w;
+assign inport_accept_o    = !cal_busy_w && ((SDRAM_PIPELINE != 0) ? (!(in_rd_q || (in_wr_q != 4'b0)) || ram_accept_w) : ram_accept_w);
+
+wire          in_load_w = inport_accept_o && (inport_rd_i || (inport_wr_i != 4'b0));
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    in_addr_q       <= 32'b0;
+    in_wr_q         <= 4'b0;
+    in_rd_q         <= 1'b0;
+    in_write_data_q <= 32'b0;
+end
+else if (in_load_w)
+begin
+    in_addr_q       <= inport_addr_i;
+    in_wr_q         <= inport_wr_i;
+    in_rd_q         <= inport_rd_i;
+    in_write_data_q <= inport_write_data_i;
+end
+else if (ram_accept_w && !cal_busy_w)
+begin
+    in_wr_q         <= 4'b0;
+    in_rd_q         <= 1'b0;
+end
 
 //-----------------------------------------------------------------
 // Registers / Wires
@@ -149,6 +263,7 @@ assign inport_accept_o    = ram_accept_w;
 //synthesis attribute IOB of dqm_q is "TRUE"
 //synthesis attribute IOB of cke_q is "TRUE"
 //synthesis attribute IOB of bank_q is "TRUE"
+//synthesis attribute IOB of rank_q is "TRUE"
 //synthesis attribute IOB of data_q is "TRUE"
 
 reg [CMD_W-1:0]        command_q;
@@ -158,6 +273,7 @@ reg                    data_rd_en_q;
 reg [SDRAM_DQM_W-1:0]  dqm_q;
 reg                    cke_q;
 reg [SDRAM_BANK_W-1:0] bank_q;
+reg [SDRAM_RANKS-1:0]  rank_q;
 
 // Buffer half word during read and write commands
 reg [SDRAM_DATA_W-1:0] data_buffer_q;
@@ -176,10 +292,123 @@ reg  [STATE_W-1:0]     target_state_r;
 reg  [STATE_W-1:0]     target_state_q;
 reg  [STATE_W-1:0]     delay_state_q;
 
-// Address bits
+// Address bits (addr_bank_w = {rank, bank})
 wire [SDRAM_ROW_W-1:0]  addr_col_w  = {{(SDRAM_ROW_W-SDRAM_COL_W){1'b0}}, ram_addr_w[SDRAM_COL_W:2], 1'b0};
-wire [SDRAM_ROW_W-1:0]  addr_row_w  = ram_addr_w[SDRAM_ADDR_W:SDRAM_COL_W+2+1];
-wire [SDRAM_BANK_W-1:0] addr_bank_w = ram_addr_w[SDRAM_COL_W+2:SDRAM_COL_W+2-1];
+wire [SDRAM_ROW_W-1:0]  addr_row_w  = ram_addr_w[SDRAM_ADDR_W+SDRAM_RANK_W:SDRAM_COL_W+SDRAM_SLOT_W+1];
+wire [SDRAM_SLOT_W-1:0] addr_bank_w = ram_addr_w[SDRAM_COL_W+SDRAM_SLOT_W:SDRAM_COL_W+1];
+
+// Chip select for the addressed rank (one-hot)
+/* verilator lint_off WIDTH */
+wire [SDRAM_RANKS-1:0]  addr_rank_w = 1 << (addr_bank_w >> SDRAM_BANK_W);
+/* verilator lint_on WIDTH */
+
+//-----------------------------------------------------------------
+// Row hit / miss lookup
+//-----------------------------------------------------------------
+// SDRAM_PIPELINE=1: looked up a cycle ahead for the request in (or
+// entering) the input stage. Open rows only change in ACTIVATE /
+// PREACT / PRECHARGE, which are never directly followed by a state that
+// uses the lookup (IDLE, READ_WAIT, WRITE1), so it is never stale when
+// used.
+wire [SDRAM_ROW_W-1:0]  lookup_row_w  = in_load_w ? inport_addr_i[SDRAM_ADDR_W+SDRAM_RANK_W:SDRAM_COL_W+SDRAM_SLOT_W+1] : addr_row_w;
+wire [SDRAM_SLOT_W-1:0] lookup_bank_w = in_load_w ? inport_addr_i[SDRAM_COL_W+SDRAM_SLOT_W:SDRAM_COL_W+1] : addr_bank_w;
+
+reg bank_open_q;
+reg row_hit_q;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    bank_open_q <= 1'b0;
+    row_hit_q   <= 1'b0;
+end
+else
+begin
+    bank_open_q <= row_open_q[lookup_bank_w];
+    row_hit_q   <= row_open_q[lookup_bank_w] && (lookup_row_w == active_row_q[lookup_bank_w]);
+end
+
+wire bank_open_w = (SDRAM_PIPELINE != 0) ? bank_open_q  : row_open_q[addr_bank_w];
+wire row_hit_w   = (SDRAM_PIPELINE != 0) ? row_hit_q    : (row_open_q[addr_bank_w] && addr_row_w == active_row_q[addr_bank_w]);
+
+//-----------------------------------------------------------------
+// Speculative next row ACTIVATE
+//-----------------------------------------------------------------
+// SDRAM_PREACTIVATE=N: once a row hit is within N words of the end of
+// its row, the row that follows it in the address map (same row in the
+// next bank, or the next row on wrapping out of the last bank) is
+// opened ahead of time if its bank is idle. A burst running off the end
+// of the row then carries on as a row hit rather than paying ACTIVATE +
+// tRCD (or PRECHARGE + tRP as well) in the middle.
+//
+// Only idle banks are opened, so no PRECHARGE is ever issued early.
+// The ACTIVATE is not followed by a tRCD delay, so the three rules it
+// starts are tracked separately while other row hits carry on:
+//   tRCD - READ / WRITE to the pre-activated bank
+//   tRRD - any other ACTIVATE (also started by a normal ACTIVATE)
+//   tRAS - PRECHARGE of the pre-activated bank (or all banks)
+localparam PREACT_W = 4;
+
+reg  [PREACT_W-1:0]     preact_rcd_q;
+reg  [PREACT_W-1:0]     preact_rrd_q;
+reg  [PREACT_W-1:0]     preact_ras_q;
+reg  [SDRAM_SLOT_W-1:0] preact_bank_q;
+
+/* verilator lint_off WIDTH */
+wire [SDRAM_SLOT_W-1:0] preact_bank_w   = addr_bank_w + 1;
+wire [SDRAM_ROW_W-1:0]  preact_row_w    = addr_row_w + (&addr_bank_w);
+wire                    preact_window_w = (ram_addr_w[SDRAM_COL_W:2] >= (SDRAM_ROW_WORDS - SDRAM_PREACTIVATE));
+wire [SDRAM_RANKS-1:0]  preact_rank_w   = 1 << (preact_bank_w >> SDRAM_BANK_W);
+/* verilator lint_on WIDTH */
+
+wire preact_rcd_w = (preact_rcd_q != {PREACT_W{1'b0}});
+wire preact_rrd_w = (preact_rrd_q != {PREACT_W{1'b0}});
+wire preact_ras_w = (preact_ras_q != {PREACT_W{1'b0}});
+
+// Issue a speculative ACTIVATE ahead of this row hit (one tracked at a time)
+wire preact_w    = (SDRAM_PREACTIVATE != 0) && !preact_rrd_w && !preact_ras_w && !refresh_q &&
+                   row_hit_w && preact_window_w && !row_open_q[preact_bank_w];
+
+// Row hit that is not waiting on the pre-activated bank's tRCD
+wire row_ready_w = row_hit_w && !(preact_rcd_w && addr_bank_w == preact_bank_q);
+
+// IDLE must wait: refresh needs PRECHARGE all (tRAS), a row hit may be
+// on the settling bank (tRCD), a row miss ends in an ACTIVATE (tRRD)
+// and may first PRECHARGE the pre-activated bank (tRAS)
+wire preact_hold_w = refresh_q ? preact_ras_w :
+                     row_hit_w ? !row_ready_w :
+                     (preact_rrd_w || (preact_ras_w && addr_bank_w == preact_bank_q));
+
+/* verilator lint_off WIDTH */
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    preact_rcd_q  <= {PREACT_W{1'b0}};
+    preact_rrd_q  <= {PREACT_W{1'b0}};
+    preact_ras_q  <= {PREACT_W{1'b0}};
+    preact_bank_q <= {SDRAM_SLOT_W{1'b0}};
+end
+else if (state_q == STATE_PREACT)
+begin
+    preact_rcd_q  <= SDRAM_TRCD_CYCLES;
+    preact_rrd_q  <= SDRAM_TRRD_CYCLES;
+    preact_ras_q  <= SDRAM_TRAS_CYCLES;
+    preact_bank_q <= preact_bank_w;
+end
+else
+begin
+    if (preact_rcd_w)
+        preact_rcd_q <= preact_rcd_q - 1;
+
+    if ((SDRAM_PREACTIVATE != 0) && state_q == STATE_ACTIVATE)
+        preact_rrd_q <= SDRAM_TRRD_CYCLES;
+    else if (preact_rrd_w)
+        preact_rrd_q <= preact_rrd_q - 1;
+
+    if (preact_ras_w)
+        preact_ras_q <= preact_ras_q - 1;
+end
+/* verilator lint_on WIDTH */
 
 //-----------------------------------------------------------------
 // SDRAM State Machine
@@ -203,10 +432,13 @@ begin
     //-----------------------------------------
     STATE_IDLE :
     begin
+        // Speculative ACTIVATE settling (see preact_hold_w)
+        if ((refresh_q || ram_req_w) && preact_hold_w)
+            ;
         // Pending refresh
         // Note: tRAS (open row time) cannot be exceeded due to periodic
         //        auto refreshes.
-        if (refresh_q)
+        else if (refresh_q)
         begin
             // Close open rows, then refresh
             if (|row_open_q)
@@ -220,15 +452,22 @@ begin
         else if (ram_req_w)
         begin
             // Open row hit
-            if (row_open_q[addr_bank_w] && addr_row_w == active_row_q[addr_bank_w])
+            if (row_hit_w)
             begin
                 if (!ram_rd_w)
                     next_state_r = STATE_WRITE0;
                 else
                     next_state_r = STATE_READ;
+
+                // Open the next row first
+                if (preact_w)
+                begin
+                    target_state_r = next_state_r;
+                    next_state_r   = STATE_PREACT;
+                end
             end
             // Row miss, close row, open new row
-            else if (row_open_q[addr_bank_w])
+            else if (bank_open_w)
             begin
                 next_state_r   = STATE_PRECHARGE;
 
@@ -258,6 +497,14 @@ begin
         next_state_r = target_state_r;
     end
     //-----------------------------------------
+    // STATE_PREACT
+    //-----------------------------------------
+    STATE_PREACT :
+    begin
+        // Proceed with the row hit
+        next_state_r = target_state_r;
+    end
+    //-----------------------------------------
     // STATE_READ
     //-----------------------------------------
     STATE_READ :
@@ -274,8 +521,13 @@ begin
         // Another pending read request (with no refresh pending)
         if (!refresh_q && ram_req_w && ram_rd_w)
         begin
-            // Open row hit
-            if (row_open_q[addr_bank_w] && addr_row_w == active_row_q[addr_bank_w])
+            // Open row hit (opening the next row first)
+            if (row_ready_w && preact_w)
+            begin
+                next_state_r   = STATE_PREACT;
+                target_state_r = STATE_READ;
+            end
+            else if (row_ready_w)
                 next_state_r = STATE_READ;
         end
     end
@@ -296,8 +548,13 @@ begin
         // Another pending write request (with no refresh pending)
         if (!refresh_q && ram_req_w && (ram_wr_w != 4'b0))
         begin
-            // Open row hit
-            if (row_open_q[addr_bank_w] && addr_row_w == active_row_q[addr_bank_w])
+            // Open row hit (opening the next row first)
+            if (row_ready_w && preact_w)
+            begin
+                next_state_r   = STATE_PREACT;
+                target_state_r = STATE_WRITE0;
+            end
+            else if (row_ready_w)
                 next_state_r = STATE_WRITE0;
         end
     end
@@ -358,16 +615,32 @@ begin
     //-----------------------------------------
     STATE_READ_WAIT :
     begin
-        delay_r = SDRAM_READ_LATENCY;
+        delay_r = rd_lat_q;
 
         // Another pending read request (with no refresh pending)
         if (!refresh_q && ram_req_w && ram_rd_w)
         begin
             // Open row hit
-            if (row_open_q[addr_bank_w] && addr_row_w == active_row_q[addr_bank_w])
+            if (row_ready_w)
                 delay_r = 4'd0;
-        end        
-    end    
+        end
+    end
+    //-----------------------------------------
+    // STATE_WRITE1
+    //-----------------------------------------
+    STATE_WRITE1 :
+    begin
+        // tWR (last write data -> PRECHARGE)
+        delay_r = SDRAM_TWR_EXTRA;
+
+        // Another pending write request (with no refresh pending)
+        if (!refresh_q && ram_req_w && (ram_wr_w != 4'b0))
+        begin
+            // Open row hit
+            if (row_ready_w)
+                delay_r = 4'd0;
+        end
+    end
     //-----------------------------------------
     // STATE_PRECHARGE
     //-----------------------------------------
@@ -459,7 +732,8 @@ else if (state_q == STATE_REFRESH)
 //-----------------------------------------------------------------
 // Input sampling
 //-----------------------------------------------------------------
-
+// SDRAM_CAPTURE_FLOPS=1 uses the first flop directly, saving a cycle
+// where the board timing allows it.
 reg [SDRAM_DATA_W-1:0] sample_data0_q;
 always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
@@ -467,12 +741,14 @@ if (rst_i)
 else
     sample_data0_q <= sdram_data_in_w;
 
-reg [SDRAM_DATA_W-1:0] sample_data_q;
+reg [SDRAM_DATA_W-1:0] sample_data1_q;
 always @ (posedge clk_i or posedge rst_i)
 if (rst_i)
-    sample_data_q <= {SDRAM_DATA_W{1'b0}};
+    sample_data1_q <= {SDRAM_DATA_W{1'b0}};
 else
-    sample_data_q <= sample_data0_q;
+    sample_data1_q <= sample_data0_q;
+
+wire [SDRAM_DATA_W-1:0] sample_data_w = (SDRAM_CAPTURE_FLOPS == 1) ? sample_data0_q : sample_data1_q;
 
 //-----------------------------------------------------------------
 // Command Output
@@ -486,6 +762,7 @@ begin
     data_q          <= 16'b0;
     addr_q          <= {SDRAM_ROW_W{1'b0}};
     bank_q          <= {SDRAM_BANK_W{1'b0}};
+    rank_q          <= {SDRAM_RANKS{1'b1}};
     cke_q           <= 1'b0; 
     dqm_q           <= {SDRAM_DQM_W{1'b0}};
     data_rd_en_q    <= 1'b1;
@@ -508,6 +785,7 @@ begin
         command_q    <= CMD_NOP;
         addr_q       <= {SDRAM_ROW_W{1'b0}};
         bank_q       <= {SDRAM_BANK_W{1'b0}};
+        rank_q       <= {SDRAM_RANKS{1'b1}};
         data_rd_en_q <= 1'b1;
     end
     //-----------------------------------------
@@ -515,6 +793,9 @@ begin
     //-----------------------------------------
     STATE_INIT:
     begin
+        // All ranks initialised together
+        rank_q <= {SDRAM_RANKS{1'b1}};
+
         // Assert CKE
         if (refresh_timer_q == 50)
         begin
@@ -555,12 +836,27 @@ begin
         // Select a row and activate it
         command_q     <= CMD_ACTIVE;
         addr_q        <= addr_row_w;
-        bank_q        <= addr_bank_w;
+        bank_q        <= addr_bank_w[SDRAM_BANK_W-1:0];
+        rank_q        <= addr_rank_w;
 
         active_row_q[addr_bank_w]  <= addr_row_w;
         row_open_q[addr_bank_w]    <= 1'b1;
     end
     //-----------------------------------------
+    // STATE_PREACT
+    //-----------------------------------------
+    STATE_PREACT :
+    begin
+        // Open the row following the current one
+        command_q     <= CMD_ACTIVE;
+        addr_q        <= preact_row_w;
+        bank_q        <= preact_bank_w[SDRAM_BANK_W-1:0];
+        rank_q        <= preact_rank_w;
+
+        active_row_q[preact_bank_w] <= preact_row_w;
+        row_open_q[preact_bank_w]   <= 1'b1;
+    end
+    //-----------------------------------------
     // STATE_PRECHARGE
     //-----------------------------------------
     STATE_PRECHARGE :
@@ -571,6 +867,7 @@ begin
             // Precharge all banks
             command_q           <= CMD_PRECHARGE;
             addr_q[ALL_BANKS]   <= 1'b1;
+            rank_q              <= {SDRAM_RANKS{1'b1}};
             row_open_q          <= {SDRAM_BANKS{1'b0}};
         end
         else
@@ -578,7 +875,8 @@ begin
             // Precharge specific banks
             command_q           <= CMD_PRECHARGE;
             addr_q[ALL_BANKS]   <= 1'b0;
-            bank_q              <= addr_bank_w;
+            bank_q              <= addr_bank_w[SDRAM_BANK_W-1:0];
+            rank_q              <= addr_rank_w;
 
             row_open_q[addr_bank_w] <= 1'b0;
         end
@@ -591,7 +889,8 @@ begin
         // Auto refresh
         command_q   <= CMD_REFRESH;
         addr_q      <= {SDRAM_ROW_W{1'b0}};
-        bank_q      <= {SDRAM_BANK_W{1'b0}};        
+        bank_q      <= {SDRAM_BANK_W{1'b0}};
+        rank_q      <= {SDRAM_RANKS{1'b1}};
     end
     //-----------------------------------------
     // STATE_READ
@@ -600,7 +899,8 @@ begin
     begin
         command_q   <= CMD_READ;
         addr_q      <= addr_col_w;
-        bank_q      <= addr_bank_w;
+        bank_q      <= addr_bank_w[SDRAM_BANK_W-1:0];
+        rank_q      <= addr_rank_w;
 
         // Disable auto precharge (auto close of row)
         addr_q[AUTO_PRECHARGE]  <= 1'b0;
@@ -615,7 +915,8 @@ begin
     begin
         command_q       <= CMD_WRITE;
         addr_q          <= addr_col_w;
-        bank_q          <= addr_bank_w;
+        bank_q          <= addr_bank_w[SDRAM_BANK_W-1:0];
+        rank_q          <= addr_rank_w;
         data_q          <= ram_write_data_w[15:0];
 
         // Disable auto precharge (auto close of row)
@@ -657,6 +958,49 @@ if (rst_i)
 else
     rd_q    <= {rd_q[SDRAM_READ_LATENCY:0], (state_q == STATE_READ)};
 
+// First read beat in the capture flops
+/* verilator lint_off WIDTH */
+wire rd_capture_w = rd_q[rd_lat_q + SDRAM_CAPTURE_FLOPS - 1];
+/* verilator lint_on WIDTH */
+
+//-----------------------------------------------------------------
+// Read latency calibration
+//-----------------------------------------------------------------
+// SDRAM_READ_CAL=1: after init, write CAL_PATTERN to CAL_ADDR then read
+// it back with the read latency stepped up from SDRAM_CAS_LATENCY until
+// it matches (SDRAM_READ_LATENCY is the upper limit, used if none do).
+// SDRAM_READ_CAL=0: fixed SDRAM_READ_LATENCY.
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    cal_state_q <= (SDRAM_READ_CAL != 0) ? CAL_WRITE : CAL_DONE;
+    rd_lat_q    <= (SDRAM_READ_CAL != 0) ? SDRAM_CAS_LATENCY : SDRAM_READ_LATENCY;
+end
+else
+begin
+    case (cal_state_q)
+    CAL_WRITE:
+        if (ram_accept_w)
+            cal_state_q <= CAL_READ;
+    CAL_READ:
+        if (ram_accept_w)
+            cal_state_q <= CAL_WAIT;
+    CAL_WAIT:
+        if (ram_ack_w)
+        begin
+            if (ram_read_data_w == CAL_PATTERN || rd_lat_q == SDRAM_READ_LATENCY)
+                cal_state_q <= CAL_DONE;
+            else
+            begin
+                rd_lat_q    <= rd_lat_q + 4'd1;
+                cal_state_q <= CAL_READ;
+            end
+        end
+    default:
+        ;
+    endcase
+end
+
 //-----------------------------------------------------------------
 // Data Buffer
 //-----------------------------------------------------------------
@@ -668,11 +1012,11 @@ if (rst_i)
     data_buffer_q <= 16'b0;
 else if (state_q == STATE_WRITE0)
     data_buffer_q <= ram_write_data_w[31:16];
-else if (rd_q[SDRAM_READ_LATENCY+1])
-    data_buffer_q <= sample_data_q;
+else if (rd_capture_w)
+    data_buffer_q <= sample_data_w;
 
 // Read data output
-assign ram_read_data_w = {sample_data_q, data_buffer_q};
+assign ram_read_data_w = {sample_data_w, data_buffer_q};
 
 //-----------------------------------------------------------------
 // ACK
@@ -686,7 +1030,7 @@ else
 begin
     if (state_q == STATE_WRITE1)
         ack_q <= 1'b1;
-    else if (rd_q[SDRAM_READ_LATENCY+1])
+    else if (rd_capture_w)
         ack_q <= 1'b1;
     else
         ack_q <= 1'b0;
@@ -706,13 +1050,22 @@ assign sdram_data_output_o   =  data_q;
 assign sdram_data_in_w       = sdram_data_input_i;
 
 assign sdram_cke_o  = cke_q;
-assign sdram_cs_o   = command_q[3];
+assign sdram_cs_o   = {SDRAM_RANKS{command_q[3]}} | ~rank_q;
 assign sdram_ras_o  = command_q[2];
 assign sdram_cas_o  = command_q[1];
 assign sdram_we_o   = command_q[0];
 assign sdram_dqm_o  = dqm_q;
 assign sdram_ba_o   = bank_q;
-assign sdram_addr_o = addr_q;
+
+// Row / column address, zero extended onto the 13 address pins
+reg [12:0] sdram_addr_r;
+always @ *
+begin
+    sdram_addr_r                    = 13'b0;
+    sdram_addr_r[SDRAM_ROW_W-1:0]   = addr_q;
+end
+
+assign sdram_addr_o = sdram_addr_r;
 
 //-----------------------------------------------------------------
 // Simulation only
@@ -733,9 +1086,20 @@ begin
     STATE_WRITE1      : dbg_state = "WRITE1";
     STATE_PRECHARGE   : dbg_state = "PRECHARGE";
     STATE_REFRESH     : dbg_state = "REFRESH";
+    STATE_PREACT      : dbg_state = "PREACT";
     default           : dbg_state = "UNKNOWN";
     endcase
 end
+
+// Calibration result
+always @ (posedge clk_i)
+if (!rst_i && cal_state_q == CAL_WAIT && ram_ack_w)
+begin
+    if (ram_read_data_w == CAL_PATTERN)
+        $display("SDRAM: read_cal read_latency=%0d", rd_lat_q);
+    else if (rd_lat_q == SDRAM_READ_LATENCY)
+        $display("ERROR: SDRAM read_cal failed (read_latency=%0d)", rd_lat_q);
+end
 `endif
 
 
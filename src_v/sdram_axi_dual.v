@@ -0,0 +1,478 @@
+//-----------------------------------------------------------------
+//                    SDRAM Controller (AXI4)
+//
+//                         License: GPL
+//-----------------------------------------------------------------
+//
+// This file is open source HDL; you can redistribute it and/or 
+// modify it under the terms of the GNU General Public License as 
+// published by the Free Software Foundation; either version 2 of 
+// the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public 
+// License along with this file; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+//-----------------------------------------------------------------
+
+module sdram_axi_dual
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter SDRAM_MHZ           = 50
+    ,parameter SDRAM_ADDR_W        = 24
+    ,parameter SDRAM_COL_W         = 9
+    ,parameter SDRAM_BANK_W        = 2
+    ,parameter SDRAM_RANK_W        = 0
+    ,parameter SDRAM_READ_LATENCY  = 2
+    ,parameter SDRAM_TRCD_NS       = 20
+    ,parameter SDRAM_TRP_NS        = 20
+    ,parameter SDRAM_TRFC_NS       = 60
+    ,parameter SDRAM_TWR_NS        = 15
+    ,parameter SDRAM_TRAS_NS       = 44
+    ,parameter SDRAM_TRRD_NS       = 15
+    ,parameter SDRAM_CAS_LATENCY   = 2
+    ,parameter SDRAM_PIPELINE      = 0
+    ,parameter SDRAM_READ_CAL      = 0
+    ,parameter SDRAM_CAPTURE_FLOPS = 2
+    ,parameter SDRAM_PREACTIVATE   = 0
+    ,parameter SDRAM_INTERLEAVE_W  = 5
+    ,parameter AXI_REQ_DEPTH       = 8
+    ,parameter AXI_RESP_DEPTH      = 8
+    ,parameter AXI_WDATA_DEPTH     = 0
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
+(
+    // Inputs
+     input           clk_i
+    ,input           rst_i
+    ,input           inport_awvalid_i
+    ,input  [ 31:0]  inport_awaddr_i
+    ,input  [  3:0]  inport_awid_i
+    ,input  [  7:0]  inport_awlen_i
+    ,input  [  1:0]  inport_awburst_i
+    ,input           inport_wvalid_i
+    ,input  [ 31:0]  inport_wdata_i
+    ,input  [  3:0]  inport_wstrb_i
+    ,input           inport_wlast_i
+    ,input           inport_bready_i
+    ,input           inport_arvalid_i
+    ,input  [ 31:0]  inport_araddr_i
+    ,input  [  3:0]  inport_arid_i
+    ,input  [  7:0]  inport_arlen_i
+    ,input  [  1:0]  inport_arburst_i
+    ,input           inport_rready_i
+    ,input  [ 15:0]  sdram_data_input_i
+    ,input  [ 15:0]  sdram1_data_input_i
+
+    // Outputs
+    ,output          inport_awready_o
+    ,output          inport_wready_o
+    ,output          inport_bvalid_o
+    ,output [  1:0]  inport_bresp_o
+    ,output [  3:0]  inport_bid_o
+    ,output          inport_arready_o
+    ,output          inport_rvalid_o
+    ,output [ 31:0]  inport_rdata_o
+    ,output [  1:0]  inport_rresp_o
+    ,output [  3:0]  inport_rid_o
+    ,output          inport_rlast_o
+    ,output          sdram_clk_o
+    ,output          sdram_cke_o
+    ,output [(1<<SDRAM_RANK_W)-1:0] sdram_cs_o
+    ,output          sdram_ras_o
+    ,output          sdram_cas_o
+    ,output          sdram_we_o
+    ,output [  1:0]  sdram_dqm_o
+    ,output [ 12:0]  sdram_addr_o
+    ,output [SDRAM_BANK_W-1:0] sdram_ba_o
+    ,output [ 15:0]  sdram_data_output_o
+    ,output          sdram_data_out_en_o
+    ,output          sdram1_clk_o
+    ,output          sdram1_cke_o
+    ,output [(1<<SDRAM_RANK_W)-1:0] sdram1_cs_o
+    ,output          sdram1_ras_o
+    ,output          sdram1_cas_o
+    ,output          sdram1_we_o
+    ,output [  1:0]  sdram1_dqm_o
+    ,output [ 12:0]  sdram1_addr_o
+    ,output [SDRAM_BANK_W-1:0] sdram1_ba_o
+    ,output [ 15:0]  sdram1_data_output_o
+    ,output          sdram1_data_out_en_o
+);
+
+//-----------------------------------------------------------------
+// Two SDRAM channels (independent buses) behind one AXI port.
+//
+// Byte address bit SDRAM_INTERLEAVE_W selects the channel, so the
+// address space alternates between channels every
+// 2^SDRAM_INTERLEAVE_W bytes (5 = 32B, 10 = 1KB). The channel bit is
+// removed from the address seen by each core.
+//
+// Bursts are split per beat: each beat is queued to its channel
+// (u_req0/1) and its channel recorded (u_order). Responses are buffered
+// per channel (u_resp0/1) and merged back into request order.
+// sdram_axi_pmem holds one credit per outstanding beat, so no FIFO here
+// can overflow. AXI_RESP_DEPTH bounds the beats in flight across both
+// channels and should cover a few interleave blocks.
+//-----------------------------------------------------------------
+`ifdef SDRAM_AXI_ASYNC
+// Single clock only
+sdram_axi_dual_async_not_supported u_error();
+`endif
+`ifdef SDRAM_AXI_STREAM
+// No streaming read port on this top
+sdram_axi_dual_stream_not_supported u_error_stream();
+`endif
+`ifdef SDRAM_AXI_XFER
+// No fill / copy engine on this top
+sdram_axi_dual_xfer_not_supported u_error_xfer();
+`endif
+
+localparam RESP_ADDR_W = $clog2(AXI_RESP_DEPTH);
+localparam REQ_W       = 4 + 1 + 8 + 32 + 32;
+
+//-----------------------------------------------------------------
+// AXI Interface
+//-----------------------------------------------------------------
+wire [ 31:0]  ram_addr_w;
+wire [  3:0]  ram_wr_w;
+wire          ram_rd_w;
+wire          ram_accept_w;
+wire [ 31:0]  ram_write_data_w;
+wire [ 31:0]  ram_read_data_w;
+wire [  7:0]  ram_len_w;
+wire          ram_ack_w;
+wire          ram_error_w;
+
+// Open row prediction (AXI_READ_REORDER) needs the single channel map
+sdram_axi_pmem
+#(
+     .AXI_READ_REORDER(0)
+    ,.SDRAM_ADDR_W(SDRAM_ADDR_W)
+    ,.SDRAM_COL_W(SDRAM_COL_W)
+    ,.SDRAM_BANK_W(SDRAM_BANK_W)
+    ,.SDRAM_RANK_W(SDRAM_RANK_W)
+    ,.AXI_REQ_DEPTH(AXI_REQ_DEPTH)
+    ,.AXI_RESP_DEPTH(AXI_RESP_DEPTH)
+    ,.AXI_WDATA_DEPTH(AXI_WDATA_DEPTH)
+)
+u_axi
+(
+    .clk_i(clk_i),
+    .rst_i(rst_i),
+
+    // AXI port
+    .axi_awvalid_i(inport_awvalid_i),
+    .axi_awaddr_i(inport_awaddr_i),
+    .axi_awid_i(inport_awid_i),
+    .axi_awlen_i(inport_awlen_i),
+    .axi_awburst_i(inport_awburst_i),
+    .axi_wvalid_i(inport_wvalid_i),
+    .axi_wdata_i(inport_wdata_i),
+    .axi_wstrb_i(inport_wstrb_i),
+    .axi_wlast_i(inport_wlast_i),
+    .axi_bready_i(inport_bready_i),
+    .axi_arvalid_i(inport_arvalid_i),
+    .axi_araddr_i(inport_araddr_i),
+    .axi_arid_i(inport_arid_i),
+    .axi_arlen_i(inport_arlen_i),
+    .axi_arburst_i(inport_arburst_i),
+    .axi_rready_i(inport_rready_i),
+    .axi_awready_o(inport_awready_o),
+    .axi_wready_o(inport_wready_o),
+    .axi_bvalid_o(inport_bvalid_o),
+    .axi_bresp_o(inport_bresp_o),
+    .axi_bid_o(inport_bid_o),
+    .axi_arready_o(inport_arready_o),
+    .axi_rvalid_o(inport_rvalid_o),
+    .axi_rdata_o(inport_rdata_o),
+    .axi_rresp_o(inport_rresp_o),
+    .axi_rid_o(inport_rid_o),
+    .axi_rlast_o(inport_rlast_o),
+    
+    // RAM interface
+    .ram_addr_o(ram_addr_w),
+    .ram_accept_i(ram_accept_w),
+    .ram_wr_o(ram_wr_w),
+    .ram_rd_o(ram_rd_w),
+    .ram_len_o(ram_len_w),
+    .ram_write_data_o(ram_write_data_w),
+    .ram_ack_i(ram_ack_w),
+    .ram_error_i(ram_error_w),
+    .ram_read_data_i(ram_read_data_w)
+);
+
+//-----------------------------------------------------------------
+// Split: beat -> channel request queue
+//-----------------------------------------------------------------
+wire          ram_req_w  = ram_rd_w || (ram_wr_w != 4'b0);
+wire          ram_ch_w   = ram_addr_w[SDRAM_INTERLEAVE_W];
+wire [ 31:0]  ch_addr_w  = {1'b0, ram_addr_w[31:SDRAM_INTERLEAVE_W+1], ram_addr_w[SDRAM_INTERLEAVE_W-1:0]};
+
+wire          order_accept_w;
+wire          order_valid_w;
+wire          order_ch_w;
+wire          req0_accept_w;
+wire          req1_accept_w;
+
+assign ram_accept_w = order_accept_w && (ram_ch_w ? req1_accept_w : req0_accept_w);
+
+wire          ram_push_w = ram_req_w && ram_accept_w;
+
+sdram_axi_pmem_fifo2
+#(
+     .WIDTH(1)
+    ,.DEPTH(AXI_RESP_DEPTH)
+    ,.ADDR_W(RESP_ADDR_W)
+)
+u_order
+(
+    .clk_i(clk_i),
+    .rst_i(rst_i),
+
+    // Input
+    .data_in_i(ram_ch_w),
+    .push_i(ram_push_w),
+    .accept_o(order_accept_w),
+
+    // Output
+    .pop_i(ram_ack_w),
+    .data_out_o(order_ch_w),
+    .valid_o(order_valid_w)
+);
+
+//-----------------------------------------------------------------
+// Channel 0
+//-----------------------------------------------------------------
+wire          req0_valid_w;
+wire [  3:0]  req0_wr_w;
+wire          req0_rd_w;
+wire [  7:0]  req0_len_w;
+wire [ 31:0]  req0_addr_w;
+wire [ 31:0]  req0_write_data_w;
+wire          core0_accept_w;
+wire          core0_ack_w;
+wire          core0_error_w;
+wire [ 31:0]  core0_read_data_w;
+wire          resp0_valid_w;
+wire [ 31:0]  resp0_data_w;
+
+sdram_axi_pmem_fifo2
+#(
+     .WIDTH(REQ_W)
+    ,.DEPTH(AXI_RESP_DEPTH)
+    ,.ADDR_W(RESP_ADDR_W)
+)
+u_req0
+(
+    .clk_i(clk_i),
+    .rst_i(rst_i),
+
+    // Input
+    .data_in_i({ram_wr_w, ram_rd_w, ram_len_w, ch_addr_w, ram_write_data_w}),
+    .push_i(ram_push_w && !ram_ch_w),
+    .accept_o(req0_accept_w),
+
+    // Output
+    .pop_i(core0_accept_w),
+    .data_out_o({req0_wr_w, req0_rd_w, req0_len_w, req0_addr_w, req0_write_data_w}),
+    .valid_o(req0_valid_w)
+);
+
+sdram_axi_core
+#(
+     .SDRAM_MHZ(SDRAM_MHZ)
+    ,.SDRAM_ADDR_W(SDRAM_ADDR_W)
+    ,.SDRAM_COL_W(SDRAM_COL_W)
+    ,.SDRAM_BANK_W(SDRAM_BANK_W)
+    ,.SDRAM_RANK_W(SDRAM_RANK_W)
+    ,.SDRAM_READ_LATENCY(SDRAM_READ_LATENCY)
+    ,.SDRAM_TRCD_NS(SDRAM_TRCD_NS)
+    ,.SDRAM_TRP_NS(SDRAM_TRP_NS)
+    ,.SDRAM_TRFC_NS(SDRAM_TRFC_NS)
+    ,.SDRAM_TWR_NS(SDRAM_TWR_NS)
+    ,.SDRAM_TRAS_NS(SDRAM_TRAS_NS)
+    ,.SDRAM_TRRD_NS(SDRAM_TRRD_NS)
+    ,.SDRAM_CAS_LATENCY(SDRAM_CAS_LATENCY)
+    ,.SDRAM_PIPELINE(SDRAM_PIPELINE)
+    ,.SDRAM_READ_CAL(SDRAM_READ_CAL)
+    ,.SDRAM_CAPTURE_FLOPS(SDRAM_CAPTURE_FLOPS)
+    ,.SDRAM_PREACTIVATE(SDRAM_PREACTIVATE)
+)
+u_core0
+(
+     .clk_i(clk_i)
+    ,.rst_i(rst_i)
+
+    ,.inport_wr_i(req0_valid_w ? req0_wr_w : 4'b0)
+    ,.inport_rd_i(req0_valid_w & req0_rd_w)
+    ,.inport_len_i(req0_len_w)
+    ,.inport_addr_i(req0_addr_w)
+    ,.inport_write_data_i(req0_write_data_w)
+    ,.inport_accept_o(core0_accept_w)
+    ,.inport_ack_o(core0_ack_w)
+    ,.inport_error_o(core0_error_w)
+    ,.inport_read_data_o(core0_read_data_w)
+
+    ,.sdram_clk_o(sdram_clk_o)
+    ,.sdram_cke_o(sdram_cke_o)
+    ,.sdram_cs_o(sdram_cs_o)
+    ,.sdram_ras_o(sdram_ras_o)
+    ,.sdram_cas_o(sdram_cas_o)
+    ,.sdram_we_o(sdram_we_o)
+    ,.sdram_dqm_o(sdram_dqm_o)
+    ,.sdram_addr_o(sdram_addr_o)
+    ,.sdram_ba_o(sdram_ba_o)
+    ,.sdram_data_output_o(sdram_data_output_o)
+    ,.sdram_data_out_en_o(sdram_data_out_en_o)
+    ,.sdram_data_input_i(sdram_data_input_i)
+);
+
+sdram_axi_pmem_fifo2
+#(
+     .WIDTH(32)
+    ,.DEPTH(AXI_RESP_DEPTH)
+    ,.ADDR_W(RESP_ADDR_W)
+)
+u_resp0
+(
+    .clk_i(clk_i),
+    .rst_i(rst_i),
+
+    // Input
+    .data_in_i(core0_read_data_w),
+    .push_i(core0_ack_w),
+    .accept_o(),
+
+    // Output
+    .pop_i(ram_ack_w && !order_ch_w),
+    .data_out_o(resp0_data_w),
+    .valid_o(resp0_valid_w)
+);
+
+//-----------------------------------------------------------------
+// Channel 1
+//-----------------------------------------------------------------
+wire          req1_valid_w;
+wire [  3:0]  req1_wr_w;
+wire          req1_rd_w;
+wire [  7:0]  req1_len_w;
+wire [ 31:0]  req1_addr_w;
+wire [ 31:0]  req1_write_data_w;
+wire          core1_accept_w;
+wire          core1_ack_w;
+wire          core1_error_w;
+wire [ 31:0]  core1_read_data_w;
+wire          resp1_valid_w;
+wire [ 31:0]  resp1_data_w;
+
+sdram_axi_pmem_fifo2
+#(
+     .WIDTH(REQ_W)
+    ,.DEPTH(AXI_RESP_DEPTH)
+    ,.ADDR_W(RESP_ADDR_W)
+)
+u_req1
+(
+    .clk_i(clk_i),
+    .rst_i(rst_i),
+
+    // Input
+    .data_in_i({ram_wr_w, ram_rd_w, ram_len_w, ch_addr_w, ram_write_data_w}),
+    .push_i(ram_push_w && ram_ch_w),
+    .accept_o(req1_accept_w),
+
+    // Output
+    .pop_i(core1_accept_w),
+    .data_out_o({req1_wr_w, req1_rd_w, req1_len_w, req1_addr_w, req1_write_data_w}),
+    .valid_o(req1_valid_w)
+);
+
+sdram_axi_core
+#(
+     .SDRAM_MHZ(SDRAM_MHZ)
+    ,.SDRAM_ADDR_W(SDRAM_ADDR_W)
+    ,.SDRAM_COL_W(SDRAM_COL_W)
+    ,.SDRAM_BANK_W(SDRAM_BANK_W)
+    ,.SDRAM_RANK_W(SDRAM_RANK_W)
+    ,.SDRAM_READ_LATENCY(SDRAM_READ_LATENCY)
+    ,.SDRAM_TRCD_NS(SDRAM_TRCD_NS)
+    ,.SDRAM_TRP_NS(SDRAM_TRP_NS)
+    ,.SDRAM_TRFC_NS(SDRAM_TRFC_NS)
+    ,.SDRAM_TWR_NS(SDRAM_TWR_NS)
+    ,.SDRAM_TRAS_NS(SDRAM_TRAS_NS)
+    ,.SDRAM_TRRD_NS(SDRAM_TRRD_NS)
+    ,.SDRAM_CAS_LATENCY(SDRAM_CAS_LATENCY)
+    ,.SDRAM_PIPELINE(SDRAM_PIPELINE)
+    ,.SDRAM_READ_CAL(SDRAM_READ_CAL)
+    ,.SDRAM_CAPTURE_FLOPS(SDRAM_CAPTURE_FLOPS)
+    ,.SDRAM_PREACTIVATE(SDRAM_PREACTIVATE)
+)
+u_core1
+(
+     .clk_i(clk_i)
+    ,.rst_i(rst_i)
+
+    ,.inport_wr_i(req1_valid_w ? req1_wr_w : 4'b0)
+    ,.inport_rd_i(req1_valid_w & req1_rd_w)
+    ,.inport_len_i(req1_len_w)
+    ,.inport_addr_i(req1_addr_w)
+    ,.inport_write_data_i(req1_write_data_w)
+    ,.inport_accept_o(core1_accept_w)
+    ,.inport_ack_o(core1_ack_w)
+    ,.inport_error_o(core1_error_w)
+    ,.inport_read_data_o(core1_read_data_w)
+
+    ,.sdram_clk_o(sdram1_clk_o)
+    ,.sdram_cke_o(sdram1_cke_o)
+    ,.sdram_cs_o(sdram1_cs_o)
+    ,.sdram_ras_o(sdram1_ras_o)
+    ,.sdram_cas_o(sdram1_cas_o)
+    ,.sdram_we_o(sdram1_we_o)
+    ,.sdram_dqm_o(sdram1_dqm_o)
+    ,.sdram_addr_o(sdram1_addr_o)
+    ,.sdram_ba_o(sdram1_ba_o)
+    ,.sdram_data_output_o(sdram1_data_output_o)
+    ,.sdram_data_out_en_o(sdram1_data_out_en_o)
+    ,.sdram_data_input_i(sdram1_data_input_i)
+);
+
+sdram_axi_pmem_fifo2
+#(
+     .WIDTH(32)
+    ,.DEPTH(AXI_RESP_DEPTH)
+    ,.ADDR_W(RESP_ADDR_W)
+)
+u_resp1
+(
+    .clk_i(clk_i),
+    .rst_i(rst_i),
+
+    // Input
+    .data_in_i(core1_read_data_w),
+    .push_i(core1_ack_w),
+    .accept_o(),
+
+    // Output
+    .pop_i(ram_ack_w && order_ch_w),
+    .data_out_o(resp1_data_w),
+    .valid_o(resp1_valid_w)
+);
+
+//-----------------------------------------------------------------
+// Merge: responses in request order
+//-----------------------------------------------------------------
+assign ram_ack_w       = order_valid_w && (order_ch_w ? resp1_valid_w : resp0_valid_w);
+assign ram_read_data_w = order_ch_w ? resp1_data_w : resp0_data_w;
+assign ram_error_w     = core0_error_w | core1_error_w;
+
+endmodule
@@ -33,6 +33,22 @@
 //-----------------------------------------------------------------
 
 module sdram_axi_pmem
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter AXI_READ_REORDER = 0
+    ,parameter SDRAM_ADDR_W     = 24
+    ,parameter SDRAM_COL_W      = 9
+    ,parameter SDRAM_BANK_W     = 2
+    ,parameter SDRAM_RANK_W     = 0
+    ,parameter AXI_REQ_DEPTH    = 4
+    ,parameter AXI_RESP_DEPTH   = 4
+    ,parameter AXI_WDATA_DEPTH  = 0
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
 (
     // Inputs
      input           clk_i
@@ -130,6 +146,167 @@ reg         req_hold_rd_q;
 reg         req_hold_wr_q;
 
 wire        req_fifo_accept_w;
+wire        resp_credit_w;
+
+// New beats need request tracking space and a response credit
+wire        req_space_w = req_fifo_accept_w & resp_credit_w;
+
+// Write data (AXI W or buffered beat)
+wire        w_valid_w;
+wire [31:0] w_data_w;
+wire [3:0]  w_strb_w;
+wire        w_last_w;
+wire        w_burst_ready_w;
+wire        w_pop_w;
+
+// Read request to issue (AXI AR or parked read)
+wire        rd_valid_w;
+wire [31:0] rd_addr_w;
+wire [3:0]  rd_id_w;
+wire [7:0]  rd_len_w;
+wire [1:0]  rd_burst_w;
+wire        rd_start_w;
+
+//-----------------------------------------------------------------
+// Read reordering (AXI_READ_REORDER)
+//-----------------------------------------------------------------
+// A read predicted to miss the open row is parked so that a later read
+// with a different ID which hits an open row can be issued ahead of it
+// (AXI allows different IDs to complete out of order). Reads with the
+// same ID never overtake each other. The open rows are predicted from
+// the last row accessed in each bank; a refresh closing them only costs
+// performance. A parked read can be overtaken PARK_OVERTAKE_MAX times.
+localparam SDRAM_SLOT_W      = SDRAM_RANK_W + SDRAM_BANK_W;
+localparam SDRAM_BANKS       = 2 ** SDRAM_SLOT_W;
+localparam SDRAM_ROW_W       = SDRAM_ADDR_W - SDRAM_COL_W - SDRAM_BANK_W;
+localparam PARK_OVERTAKE_MAX = 4'd8;
+
+reg                    park_valid_q;
+reg [31:0]             park_addr_q;
+reg [3:0]              park_id_q;
+reg [7:0]              park_len_q;
+reg [1:0]              park_burst_q;
+reg [3:0]              park_credit_q;
+
+reg [SDRAM_ROW_W-1:0]  last_row_q[0:SDRAM_BANKS-1];
+reg [SDRAM_BANKS-1:0]  last_row_valid_q;
+
+wire [SDRAM_SLOT_W-1:0] ar_bank_w = axi_araddr_i[SDRAM_COL_W+SDRAM_SLOT_W:SDRAM_COL_W+1];
+wire [SDRAM_ROW_W-1:0]  ar_row_w  = axi_araddr_i[SDRAM_ADDR_W+SDRAM_RANK_W:SDRAM_COL_W+SDRAM_SLOT_W+1];
+wire                    ar_hit_w  = last_row_valid_q[ar_bank_w] && (last_row_q[ar_bank_w] == ar_row_w);
+
+// AR row miss -> park slot
+wire park_w   = (AXI_READ_REORDER != 0) && axi_arvalid_i && !park_valid_q && !ar_hit_w;
+
+// AR row hit (other ID) -> ahead of the parked read
+wire bypass_w = (AXI_READ_REORDER != 0) && axi_arvalid_i && park_valid_q && ar_hit_w &&
+                (axi_arid_i != park_id_q) && (park_credit_q != 4'd0);
+
+wire rd_park_w = park_valid_q && !bypass_w;
+
+assign rd_valid_w = (AXI_READ_REORDER == 0) ? axi_arvalid_i :
+                    (rd_park_w | bypass_w | (!park_valid_q && axi_arvalid_i && ar_hit_w));
+assign rd_addr_w  = rd_park_w ? park_addr_q  : axi_araddr_i;
+assign rd_id_w    = rd_park_w ? park_id_q    : axi_arid_i;
+assign rd_len_w   = rd_park_w ? park_len_q   : axi_arlen_i;
+assign rd_burst_w = rd_park_w ? park_burst_q : axi_arburst_i;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    park_valid_q  <= 1'b0;
+    park_addr_q   <= 32'b0;
+    park_id_q     <= 4'b0;
+    park_len_q    <= 8'b0;
+    park_burst_q  <= 2'b0;
+    park_credit_q <= 4'b0;
+end
+else if (park_w)
+begin
+    park_valid_q  <= 1'b1;
+    park_addr_q   <= axi_araddr_i;
+    park_id_q     <= axi_arid_i;
+    park_len_q    <= axi_arlen_i;
+    park_burst_q  <= axi_arburst_i;
+    park_credit_q <= PARK_OVERTAKE_MAX;
+end
+else if (rd_start_w && rd_park_w)
+    park_valid_q  <= 1'b0;
+else if (rd_start_w && bypass_w)
+    park_credit_q <= park_credit_q - 4'd1;
+
+// Last row accessed per bank (open row prediction)
+wire [SDRAM_SLOT_W-1:0] ram_bank_w = ram_addr_o[SDRAM_COL_W+SDRAM_SLOT_W:SDRAM_COL_W+1];
+wire [SDRAM_ROW_W-1:0]  ram_row_w  = ram_addr_o[SDRAM_ADDR_W+SDRAM_RANK_W:SDRAM_COL_W+SDRAM_SLOT_W+1];
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    last_row_valid_q <= {SDRAM_BANKS{1'b0}};
+else if ((ram_rd_o || ram_wr_o != 4'b0) && ram_accept_i)
+begin
+    last_row_q[ram_bank_w]       <= ram_row_w;
+    last_row_valid_q[ram_bank_w] <= 1'b1;
+end
+
+//-----------------------------------------------------------------
+// Write data buffering (AXI_WDATA_DEPTH)
+//-----------------------------------------------------------------
+// AXI_WDATA_DEPTH=0: W beats are taken straight from the bus alongside
+// the address path, so WREADY waits for AW and the core.
+// AXI_WDATA_DEPTH=N: W beats are buffered as they arrive, independent of
+// AW. A write burst is only started once all of its data is buffered
+// (or the buffer is full), so it streams into the core from the first
+// beat and reads are not held up by a master that is slow with W.
+localparam WDATA_FIFO_DEPTH  = (AXI_WDATA_DEPTH == 0) ? 2 : AXI_WDATA_DEPTH;
+localparam WDATA_ADDR_W      = $clog2(WDATA_FIFO_DEPTH);
+
+wire        wdata_accept_w;
+wire        wdata_valid_w;
+wire [36:0] wdata_out_w;
+
+sdram_axi_pmem_fifo2
+#(
+     .WIDTH(32 + 4 + 1)
+    ,.DEPTH(WDATA_FIFO_DEPTH)
+    ,.ADDR_W(WDATA_ADDR_W)
+)
+u_wdata
+(
+    .clk_i(clk_i),
+    .rst_i(rst_i),
+
+    // Input
+    .data_in_i({axi_wlast_i, axi_wstrb_i, axi_wdata_i}),
+    .push_i((AXI_WDATA_DEPTH != 0) && axi_wvalid_i),
+    .accept_o(wdata_accept_w),
+
+    // Output
+    .pop_i(w_pop_w),
+    .data_out_o(wdata_out_w),
+    .valid_o(wdata_valid_w)
+);
+
+// Complete bursts (WLAST) in the buffer
+reg [WDATA_ADDR_W:0] wdata_bursts_q;
+
+wire wdata_push_last_w = axi_wvalid_i && wdata_accept_w && axi_wlast_i;
+wire wdata_pop_last_w  = w_pop_w && wdata_out_w[36];
+
+/* verilator lint_off WIDTH */
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    wdata_bursts_q <= {(WDATA_ADDR_W+1){1'b0}};
+else if ((AXI_WDATA_DEPTH != 0) && wdata_push_last_w && !wdata_pop_last_w)
+    wdata_bursts_q <= wdata_bursts_q + 1;
+else if ((AXI_WDATA_DEPTH != 0) && !wdata_push_last_w && wdata_pop_last_w)
+    wdata_bursts_q <= wdata_bursts_q - 1;
+/* verilator lint_on WIDTH */
+
+assign w_valid_w       = (AXI_WDATA_DEPTH != 0) ? wdata_valid_w       : axi_wvalid_i;
+assign w_data_w        = (AXI_WDATA_DEPTH != 0) ? wdata_out_w[31:0]   : axi_wdata_i;
+assign w_strb_w        = (AXI_WDATA_DEPTH != 0) ? wdata_out_w[35:32]  : axi_wstrb_i;
+assign w_last_w        = (AXI_WDATA_DEPTH != 0) ? wdata_out_w[36]     : axi_wlast_i;
+assign w_burst_ready_w = (AXI_WDATA_DEPTH != 0) ? ((wdata_bursts_q != {(WDATA_ADDR_W+1){1'b0}}) || !wdata_accept_w) : 1'b1;
 
 //-----------------------------------------------------------------
 // Sequential
@@ -167,9 +344,9 @@ begin
     if (axi_awvalid_i && axi_awready_o)
     begin
         // Data ready?
-        if (axi_wvalid_i && axi_wready_o)
+        if (w_valid_w)
         begin
-            req_wr_q      <= !axi_wlast_i;
+            req_wr_q      <= !w_last_w;
             req_len_q     <= axi_awlen_i - 8'd1;
             req_id_q      <= axi_awid_i;
             req_axburst_q <= axi_awburst_i;
@@ -189,14 +366,14 @@ begin
         req_prio_q    <= !req_prio_q;
     end
     // Read command accepted
-    else if (axi_arvalid_i && axi_arready_o)
+    else if (rd_start_w)
     begin
-        req_rd_q      <= (axi_arlen_i != 0);
-        req_len_q     <= axi_arlen_i - 8'd1;
-        req_addr_q    <= calculate_addr_next(axi_araddr_i, axi_arburst_i, axi_arlen_i);
-        req_id_q      <= axi_arid_i;
-        req_axburst_q <= axi_arburst_i;
-        req_axlen_q   <= axi_arlen_i;
+        req_rd_q      <= (rd_len_w != 0);
+        req_len_q     <= rd_len_w - 8'd1;
+        req_addr_q    <= calculate_addr_next(rd_addr_w, rd_burst_w, rd_len_w);
+        req_id_q      <= rd_id_w;
+        req_axburst_q <= rd_burst_w;
+        req_axlen_q   <= rd_len_w;
         req_prio_q    <= !req_prio_q;
     end
 end
@@ -230,14 +407,15 @@ wire       req_out_valid_w;
 wire [5:0] req_out_w;
 wire       resp_accept_w;
 
+localparam REQ_ADDR_W = $clog2(AXI_REQ_DEPTH);
 
 always @ *
 begin
     req_in_r = 6'b0;
 
     // First cycle of read burst
-    if (axi_arvalid_i && axi_arready_o)
-        req_in_r = {1'b1, (axi_arlen_i == 8'd0), axi_arid_i};
+    if (rd_start_w)
+        req_in_r = {1'b1, (rd_len_w == 8'd0), rd_id_w};
     // First cycle of write burst
     else if (axi_awvalid_i && axi_awready_o)
         req_in_r = {1'b0, (axi_awlen_i == 8'd0), axi_awid_i};
@@ -247,7 +425,11 @@ begin
 end
 
 sdram_axi_pmem_fifo2
-#( .WIDTH(1 + 1 + 4) )
+#(
+     .WIDTH(1 + 1 + 4)
+    ,.DEPTH(AXI_REQ_DEPTH)
+    ,.ADDR_W(REQ_ADDR_W)
+)
 u_requests
 (
     .clk_i(clk_i),
@@ -269,13 +451,46 @@ wire resp_is_read_w  = req_out_valid_w ? req_out_w[5]  : 1'b0;
 wire resp_is_last_w  = req_out_w[4];
 wire [3:0] resp_id_w = req_out_w[3:0];
 
+//-----------------------------------------------------------------
+// Response credits
+//-----------------------------------------------------------------
+// One credit per u_response entry, taken when a beat is issued to the
+// core and returned when its response leaves. A beat is only issued if
+// its response can be buffered, so RREADY / BREADY backpressure never
+// overflows u_response and the core keeps streaming until it is full.
+localparam RESP_ADDR_W = $clog2(AXI_RESP_DEPTH);
+
+reg [RESP_ADDR_W:0] resp_credit_q;
+
+/* verilator lint_off WIDTH */
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    resp_credit_q <= AXI_RESP_DEPTH;
+else if (req_push_w && !resp_accept_w)
+    resp_credit_q <= resp_credit_q - 1;
+else if (!req_push_w && resp_accept_w)
+    resp_credit_q <= resp_credit_q + 1;
+/* verilator lint_on WIDTH */
+
+assign resp_credit_w = (resp_credit_q != {(RESP_ADDR_W+1){1'b0}});
+
 //-----------------------------------------------------------------
 // Response buffering
 //-----------------------------------------------------------------
-wire resp_valid_w;
+wire        resp_valid_w;
+wire        resp_fifo_valid_w;
+wire [31:0] resp_fifo_data_w;
+
+// Nothing buffered: present the response straight from the core
+// (critical word first of a burst arrives a cycle earlier).
+wire        resp_bypass_w = !resp_fifo_valid_w && ram_ack_i;
 
 sdram_axi_pmem_fifo2
-#( .WIDTH(32) )
+#(
+     .WIDTH(32)
+    ,.DEPTH(AXI_RESP_DEPTH)
+    ,.ADDR_W(RESP_ADDR_W)
+)
 u_response
 (
     .clk_i(clk_i),
@@ -283,15 +498,18 @@ u_response
 
     // Input
     .data_in_i(ram_read_data_i),
-    .push_i(ram_ack_i),
+    .push_i(ram_ack_i && !(resp_bypass_w && resp_accept_w)),
     .accept_o(),
 
     // Output
     .pop_i(resp_accept_w),
-    .data_out_o(axi_rdata_o),
-    .valid_o(resp_valid_w)
+    .data_out_o(resp_fifo_data_w),
+    .valid_o(resp_fifo_valid_w)
 );
 
+assign resp_valid_w = resp_fifo_valid_w | resp_bypass_w;
+assign axi_rdata_o  = resp_fifo_valid_w ? resp_fifo_data_w : ram_read_data_i;
+
 //-----------------------------------------------------------------
 // RAM Request
 //-----------------------------------------------------------------
@@ -300,26 +518,33 @@ u_response
 wire write_prio_w   = ((req_prio_q  & !req_hold_rd_q) | req_hold_wr_q);
 wire read_prio_w    = ((!req_prio_q & !req_hold_wr_q) | req_hold_rd_q);
 
-wire write_active_w  = (axi_awvalid_i || req_wr_q) && !req_rd_q && req_fifo_accept_w && (write_prio_w || req_wr_q || !axi_arvalid_i);
-wire read_active_w   = (axi_arvalid_i || req_rd_q) && !req_wr_q && req_fifo_accept_w && (read_prio_w || req_rd_q || !axi_awvalid_i);
+// New write bursts wait for their data (AXI_WDATA_DEPTH)
+wire aw_valid_w      = axi_awvalid_i && w_burst_ready_w;
 
-assign axi_awready_o = write_active_w && !req_wr_q && ram_accept_i && req_fifo_accept_w;
-assign axi_wready_o  = write_active_w &&              ram_accept_i && req_fifo_accept_w;
-assign axi_arready_o = read_active_w  && !req_rd_q && ram_accept_i && req_fifo_accept_w;
+wire write_active_w  = (aw_valid_w || req_wr_q) && !req_rd_q && req_space_w && (write_prio_w || req_wr_q || !rd_valid_w);
+wire read_active_w   = (rd_valid_w || req_rd_q) && !req_wr_q && req_space_w && (read_prio_w || req_rd_q || !aw_valid_w);
+
+assign axi_awready_o = write_active_w && !req_wr_q && ram_accept_i && req_space_w;
+assign axi_wready_o  = (AXI_WDATA_DEPTH != 0) ? wdata_accept_w :
+                       (write_active_w && ram_accept_i && req_space_w);
+assign rd_start_w    = read_active_w  && !req_rd_q && ram_accept_i && req_space_w;
+assign axi_arready_o = park_w || (rd_start_w && !rd_park_w);
 
 wire [31:0] addr_w   = ((req_wr_q || req_rd_q) ? req_addr_q:
-                        write_active_w ? axi_awaddr_i : axi_araddr_i);
+                        write_active_w ? axi_awaddr_i : rd_addr_w);
 
-wire wr_w    = write_active_w && axi_wvalid_i;
+wire wr_w    = write_active_w && w_valid_w;
 wire rd_w    = read_active_w;
 
+assign w_pop_w = wr_w && ram_accept_i;
+
 // RAM if
 assign ram_addr_o       = addr_w;
-assign ram_write_data_o = axi_wdata_i;
+assign ram_write_data_o = w_data_w;
 assign ram_rd_o         = rd_w;
-assign ram_wr_o         = wr_w ? axi_wstrb_i : 4'b0;
-assign ram_len_o        = axi_awvalid_i ? axi_awlen_i:
-                          axi_arvalid_i ? axi_arlen_i : 8'b0;
+assign ram_wr_o         = wr_w ? w_strb_w : 4'b0;
+assign ram_len_o        = aw_valid_w    ? axi_awlen_i:
+                          rd_valid_w    ? rd_len_w    : 8'b0;
 
 //-----------------------------------------------------------------
 // Response
@@ -374,6 +599,14 @@ module sdram_axi_pmem_fifo2
 //-----------------------------------------------------------------
 localparam COUNT_W = ADDR_W + 1;
 
+// Pointers wrap at 2^ADDR_W: DEPTH must be that power of 2 (2 or more)
+generate
+if (DEPTH < 2 || DEPTH != (2 ** ADDR_W))
+begin : g_depth_check
+    sdram_axi_fifo_depth_not_power_of_2 u_error_depth();
+end
+endgenerate
+
 //-----------------------------------------------------------------
 // Registers
 //-----------------------------------------------------------------
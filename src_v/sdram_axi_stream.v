@@ -0,0 +1,255 @@
+//-----------------------------------------------------------------
+//                    SDRAM Controller (AXI4)
+//
+//                         License: GPL
+//-----------------------------------------------------------------
+//
+// This file is open source HDL; you can redistribute it and/or 
+// modify it under the terms of the GNU General Public License as 
+// published by the Free Software Foundation; either version 2 of 
+// the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public 
+// License along with this file; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+//-----------------------------------------------------------------
+
+module sdram_axi_stream
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter SDRAM_COL_W        = 9
+    ,parameter STREAM_DEPTH       = 512
+    ,parameter STREAM_WATERMARK   = 256
+    ,parameter STREAM_OUTSTANDING = 8
+    ,parameter AXI_RESP_DEPTH     = 4
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
+(
+    // Inputs
+     input           clk_i
+    ,input           rst_i
+    ,input           stream_start_i
+    ,input  [ 31:0]  stream_addr_i
+    ,input  [ 31:0]  stream_len_i
+    ,input           stream_ready_i
+    ,input  [  3:0]  inport_wr_i
+    ,input           inport_rd_i
+    ,input  [  7:0]  inport_len_i
+    ,input  [ 31:0]  inport_addr_i
+    ,input  [ 31:0]  inport_write_data_i
+    ,input           outport_accept_i
+    ,input           outport_ack_i
+    ,input           outport_error_i
+    ,input  [ 31:0]  outport_read_data_i
+
+    // Outputs
+    ,output          stream_valid_o
+    ,output [ 31:0]  stream_data_o
+    ,output          stream_busy_o
+    ,output          inport_accept_o
+    ,output          inport_ack_o
+    ,output          inport_error_o
+    ,output [ 31:0]  inport_read_data_o
+    ,output [  3:0]  outport_wr_o
+    ,output          outport_rd_o
+    ,output [  7:0]  outport_len_o
+    ,output [ 31:0]  outport_addr_o
+    ,output [ 31:0]  outport_write_data_o
+);
+
+//-----------------------------------------------------------------
+// Streaming read port (e.g. display refresh)
+//
+// stream_start_i loads a word aligned start address and a length in
+// 32-bit words. It is ignored while stream_busy_o is high (the previous
+// frame still has words to fetch, in flight or buffered). Words are
+// prefetched in address order into a STREAM_DEPTH entry FIFO, space
+// for each beat being reserved when it is issued.
+//
+// Below STREAM_WATERMARK words (buffered + in flight) the stream takes
+// priority over the AXI port and keeps it until the end of the SDRAM
+// row, so the refill runs as row hits. Above the watermark it only
+// uses cycles the AXI port leaves idle.
+//
+// Responses return in request order; u_owner records which side each
+// beat belongs to.
+//-----------------------------------------------------------------
+localparam LEVEL_W     = $clog2(STREAM_DEPTH);
+localparam OUT_W       = $clog2(STREAM_OUTSTANDING);
+localparam OWNER_DEPTH = 2 ** $clog2(AXI_RESP_DEPTH + STREAM_OUTSTANDING);
+localparam OWNER_W     = $clog2(OWNER_DEPTH);
+
+reg [31:0]        fetch_addr_q;
+reg [31:0]        fetch_remain_q;
+reg [LEVEL_W:0]   level_q;
+reg [OUT_W:0]     outstanding_q;
+reg               hold_q;
+reg               owner_hold_q;
+reg               owner_hold_stream_q;
+
+wire              owner_accept_w;
+wire              owner_stream_w;
+wire              fifo_valid_w;
+
+/* verilator lint_off WIDTH */
+wire fetch_active_w = (fetch_remain_q != 32'b0);
+wire space_w        = (level_q != STREAM_DEPTH);
+wire urgent_w       = (level_q <  STREAM_WATERMARK);
+wire can_issue_w    = fetch_active_w && space_w && (outstanding_q != STREAM_OUTSTANDING);
+/* verilator lint_on WIDTH */
+
+// Last word of the SDRAM row (row = 2^(SDRAM_COL_W+1) bytes)
+wire row_last_w     = (&fetch_addr_q[SDRAM_COL_W:2]);
+
+wire in_req_w       = inport_rd_i || (inport_wr_i != 4'b0);
+
+// Stream wants the port this cycle (may still be waiting on a credit)
+wire stream_want_w  = fetch_active_w && space_w && (hold_q || urgent_w || !in_req_w);
+
+// Stream owns the port: a request presented to the core keeps its owner
+// until accepted (the core decides row hit / miss before accepting)
+wire stream_sel_w   = owner_hold_q ? owner_hold_stream_q : stream_want_w;
+
+wire issue_w        = stream_sel_w && can_issue_w && outport_accept_i && owner_accept_w;
+wire pop_w          = stream_ready_i && fifo_valid_w;
+wire stream_ack_w   = outport_ack_i && owner_stream_w;
+
+//-----------------------------------------------------------------
+// Fetch state
+//-----------------------------------------------------------------
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    fetch_addr_q   <= 32'b0;
+    fetch_remain_q <= 32'b0;
+end
+else if (stream_start_i && !stream_busy_o)
+begin
+    fetch_addr_q   <= {stream_addr_i[31:2], 2'b0};
+    fetch_remain_q <= stream_len_i;
+end
+else if (issue_w)
+begin
+    fetch_addr_q   <= fetch_addr_q + 32'd4;
+    fetch_remain_q <= fetch_remain_q - 32'd1;
+end
+
+// Urgent refill: hold the port until the end of the row
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    hold_q <= 1'b0;
+else if (!fetch_active_w || !space_w)
+    hold_q <= 1'b0;
+else if (issue_w)
+    hold_q <= (hold_q || urgent_w) && !row_last_w;
+
+// FIFO entries + beats in flight
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    level_q <= {(LEVEL_W+1){1'b0}};
+else if (issue_w && !pop_w)
+    level_q <= level_q + 1;
+else if (!issue_w && pop_w)
+    level_q <= level_q - 1;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    outstanding_q <= {(OUT_W+1){1'b0}};
+else if (issue_w && !stream_ack_w)
+    outstanding_q <= outstanding_q + 1;
+else if (!issue_w && stream_ack_w)
+    outstanding_q <= outstanding_q - 1;
+
+//-----------------------------------------------------------------
+// Request mux
+//-----------------------------------------------------------------
+assign outport_rd_o         = stream_sel_w ? (can_issue_w && owner_accept_w) : (inport_rd_i && owner_accept_w);
+assign outport_wr_o         = (stream_sel_w || !owner_accept_w) ? 4'b0 : inport_wr_i;
+assign outport_len_o        = stream_sel_w ? 8'd0 : inport_len_i;
+assign outport_addr_o       = stream_sel_w ? fetch_addr_q : inport_addr_i;
+assign outport_write_data_o = inport_write_data_i;
+
+assign inport_accept_o      = !stream_sel_w && outport_accept_i && owner_accept_w;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    owner_hold_q        <= 1'b0;
+    owner_hold_stream_q <= 1'b0;
+end
+else if ((outport_rd_o || (outport_wr_o != 4'b0)) && !outport_accept_i)
+begin
+    owner_hold_q        <= 1'b1;
+    owner_hold_stream_q <= stream_sel_w;
+end
+else if (outport_accept_i)
+    owner_hold_q        <= 1'b0;
+
+//-----------------------------------------------------------------
+// Response routing
+//-----------------------------------------------------------------
+sdram_axi_pmem_fifo2
+#(
+     .WIDTH(1)
+    ,.DEPTH(OWNER_DEPTH)
+    ,.ADDR_W(OWNER_W)
+)
+u_owner
+(
+    .clk_i(clk_i),
+    .rst_i(rst_i),
+
+    // Input
+    .data_in_i(stream_sel_w),
+    .push_i((outport_rd_o || (outport_wr_o != 4'b0)) && outport_accept_i),
+    .accept_o(owner_accept_w),
+
+    // Output
+    .pop_i(outport_ack_i),
+    .data_out_o(owner_stream_w),
+    .valid_o()
+);
+
+assign inport_ack_o       = outport_ack_i && !owner_stream_w;
+assign inport_error_o     = outport_error_i;
+assign inport_read_data_o = outport_read_data_i;
+
+//-----------------------------------------------------------------
+// Stream FIFO (space reserved at issue, cannot overflow)
+//-----------------------------------------------------------------
+sdram_axi_pmem_fifo2
+#(
+     .WIDTH(32)
+    ,.DEPTH(STREAM_DEPTH)
+    ,.ADDR_W(LEVEL_W)
+)
+u_fifo
+(
+    .clk_i(clk_i),
+    .rst_i(rst_i),
+
+    // Input
+    .data_in_i(outport_read_data_i),
+    .push_i(stream_ack_w),
+    .accept_o(),
+
+    // Output
+    .pop_i(stream_ready_i),
+    .data_out_o(stream_data_o),
+    .valid_o(fifo_valid_w)
+);
+
+assign stream_valid_o = fifo_valid_w;
+assign stream_busy_o  = fetch_active_w || (level_q != {(LEVEL_W+1){1'b0}});
+
+endmodule
@@ -0,0 +1,388 @@
+//-----------------------------------------------------------------
+//                    SDRAM Controller (AXI4)
+//
+//                         License: GPL
+//-----------------------------------------------------------------
+//
+// This file is open source HDL; you can redistribute it and/or 
+// modify it under the terms of the GNU General Public License as 
+// published by the Free Software Foundation; either version 2 of 
+// the License, or (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public 
+// License along with this file; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307
+// USA
+//-----------------------------------------------------------------
+
+module sdram_axi_xfer
+//-----------------------------------------------------------------
+// Params
+//-----------------------------------------------------------------
+#(
+     parameter SDRAM_COL_W        = 9
+    ,parameter XFER_BUF_DEPTH     = 256
+    ,parameter XFER_OUTSTANDING   = 8
+    ,parameter INPORT_OUTSTANDING = 4
+)
+//-----------------------------------------------------------------
+// Ports
+//-----------------------------------------------------------------
+(
+    // Inputs
+     input           clk_i
+    ,input           rst_i
+    ,input           xfer_start_i
+    ,input           xfer_copy_i
+    ,input  [ 31:0]  xfer_src_i
+    ,input  [ 31:0]  xfer_dst_i
+    ,input  [ 31:0]  xfer_len_i
+    ,input  [ 31:0]  xfer_fill_data_i
+    ,input  [  3:0]  inport_wr_i
+    ,input           inport_rd_i
+    ,input  [  7:0]  inport_len_i
+    ,input  [ 31:0]  inport_addr_i
+    ,input  [ 31:0]  inport_write_data_i
+    ,input           outport_accept_i
+    ,input           outport_ack_i
+    ,input           outport_error_i
+    ,input  [ 31:0]  outport_read_data_i
+
+    // Outputs
+    ,output          xfer_busy_o
+    ,output          xfer_done_o
+    ,output          inport_accept_o
+    ,output          inport_ack_o
+    ,output          inport_error_o
+    ,output [ 31:0]  inport_read_data_o
+    ,output [  3:0]  outport_wr_o
+    ,output          outport_rd_o
+    ,output [  7:0]  outport_len_o
+    ,output [ 31:0]  outport_addr_o
+    ,output [ 31:0]  outport_write_data_o
+);
+
+//-----------------------------------------------------------------
+// Fill / copy engine
+//
+// xfer_start_i (while not busy) starts a job of xfer_len_i 32-bit
+// words at word aligned addresses;
+//   fill (xfer_copy_i=0): write xfer_fill_data_i from xfer_dst_i
+//   copy (xfer_copy_i=1): copy from xfer_src_i to xfer_dst_i
+// xfer_done_o pulses once the last write has completed.
+//
+// A copy runs forwards like memcpy: the regions may only overlap with
+// xfer_dst_i <= xfer_src_i. With xfer_dst_i inside
+// (xfer_src_i, xfer_src_i + 4 * xfer_len_i) a batch's writes overwrite
+// source words a later batch has yet to read, and the result is
+// corrupt. This is not checked.
+//
+// Work is done in batches that stay within one SDRAM row (for a copy,
+// within both the source and destination rows, and up to
+// XFER_BUF_DEPTH words): a copy reads the whole batch into u_buf, then
+// writes it back, so the core sees runs of row hits rather than
+// alternating between two rows each word. The engine holds the port
+// for a batch, then lets one pending AXI beat through.
+//
+// Accesses are not ordered against AXI traffic to the same addresses.
+//-----------------------------------------------------------------
+localparam ROW_WORDS   = 2 ** (SDRAM_COL_W - 1);
+localparam BUF_W       = $clog2(XFER_BUF_DEPTH);
+localparam OUT_W       = $clog2(XFER_OUTSTANDING);
+localparam OWNER_DEPTH = 2 ** $clog2(INPORT_OUTSTANDING + XFER_OUTSTANDING);
+localparam OWNER_W     = $clog2(OWNER_DEPTH);
+
+localparam STATE_W           = 3;
+localparam STATE_IDLE        = 3'd0;
+localparam STATE_FILL        = 3'd1;
+localparam STATE_READ        = 3'd2;
+localparam STATE_WRITE       = 3'd3;
+localparam STATE_FLUSH       = 3'd4;
+
+reg [STATE_W-1:0] state_q;
+reg [31:0]        src_q;
+reg [31:0]        dst_q;
+reg [31:0]        remain_q;
+reg [31:0]        fill_q;
+reg [BUF_W:0]     batch_q;
+reg [BUF_W:0]     count_q;
+reg [OUT_W:0]     outstanding_q;
+reg               yield_q;
+reg               owner_hold_q;
+reg               owner_hold_eng_q;
+reg               done_q;
+
+wire              owner_accept_w;
+wire [1:0]        owner_w;
+wire              buf_valid_w;
+wire [31:0]       buf_data_w;
+
+wire in_req_w     = inport_rd_i || (inport_wr_i != 4'b0);
+
+//-----------------------------------------------------------------
+// Batch size: rest of the job, row(s) and buffer
+//-----------------------------------------------------------------
+/* verilator lint_off WIDTH */
+wire [31:0] src_left_w = ROW_WORDS - src_q[SDRAM_COL_W:2];
+wire [31:0] dst_left_w = ROW_WORDS - dst_q[SDRAM_COL_W:2];
+
+reg [31:0] batch_r;
+always @ *
+begin
+    batch_r = remain_q;
+
+    if (src_left_w < batch_r)
+        batch_r = src_left_w;
+    if (dst_left_w < batch_r)
+        batch_r = dst_left_w;
+    if (XFER_BUF_DEPTH < batch_r)
+        batch_r = XFER_BUF_DEPTH;
+end
+
+wire can_issue_w  = (outstanding_q != XFER_OUTSTANDING) && owner_accept_w;
+/* verilator lint_on WIDTH */
+
+//-----------------------------------------------------------------
+// Engine requests
+//-----------------------------------------------------------------
+// Engine wants the port this cycle
+wire eng_want_w   = (state_q == STATE_FILL || state_q == STATE_READ || state_q == STATE_WRITE) && !yield_q;
+
+// Engine owns the port: a request presented to the core keeps its owner
+// until accepted (an AXI beat is never replaced mid-request)
+wire eng_sel_w    = owner_hold_q ? owner_hold_eng_q : eng_want_w;
+
+wire eng_rd_w     = (state_q == STATE_READ)  && (count_q != batch_q) && can_issue_w;
+wire eng_wr_w     = ((state_q == STATE_FILL) || (state_q == STATE_WRITE && buf_valid_w)) && can_issue_w;
+
+wire eng_issue_w  = eng_sel_w && (eng_rd_w || eng_wr_w) && outport_accept_i;
+wire eng_ack_w    = outport_ack_i && owner_w[1];
+
+// Last word of the destination row / of the copy batch
+wire dst_row_last_w = (&dst_q[SDRAM_COL_W:2]);
+/* verilator lint_off WIDTH */
+wire batch_last_w   = ((count_q + 1) == batch_q);
+/* verilator lint_on WIDTH */
+wire job_last_w     = (remain_q == 32'd1);
+
+//-----------------------------------------------------------------
+// State machine
+//-----------------------------------------------------------------
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    state_q  <= STATE_IDLE;
+    src_q    <= 32'b0;
+    dst_q    <= 32'b0;
+    remain_q <= 32'b0;
+    fill_q   <= 32'b0;
+    batch_q  <= {(BUF_W+1){1'b0}};
+    count_q  <= {(BUF_W+1){1'b0}};
+    yield_q  <= 1'b0;
+    done_q   <= 1'b0;
+end
+else
+begin
+    done_q <= 1'b0;
+
+    // Let one AXI beat through (or none if AXI is idle)
+    if (yield_q && (!in_req_w || (outport_accept_i && owner_accept_w)))
+        yield_q <= 1'b0;
+
+    case (state_q)
+    STATE_IDLE :
+    begin
+        if (xfer_start_i)
+        begin
+            src_q    <= {xfer_src_i[31:2], 2'b0};
+            dst_q    <= {xfer_dst_i[31:2], 2'b0};
+            remain_q <= xfer_len_i;
+            fill_q   <= xfer_fill_data_i;
+            count_q  <= {(BUF_W+1){1'b0}};
+
+            if (xfer_len_i == 32'b0)
+                done_q  <= 1'b1;
+            else
+                state_q <= xfer_copy_i ? STATE_READ : STATE_FILL;
+        end
+    end
+    //-----------------------------------------
+    // FILL - Row runs of writes
+    //-----------------------------------------
+    STATE_FILL :
+    begin
+        if (eng_issue_w)
+        begin
+            dst_q    <= dst_q + 32'd4;
+            remain_q <= remain_q - 32'd1;
+
+            if (job_last_w)
+                state_q <= STATE_FLUSH;
+            else if (dst_row_last_w)
+                yield_q <= in_req_w;
+        end
+    end
+    //-----------------------------------------
+    // READ - Copy batch into u_buf
+    //-----------------------------------------
+    STATE_READ :
+    begin
+        /* verilator lint_off WIDTH */
+        if (count_q == {(BUF_W+1){1'b0}} && batch_q == {(BUF_W+1){1'b0}})
+            batch_q <= batch_r;
+        /* verilator lint_on WIDTH */
+        else if (eng_issue_w)
+        begin
+            src_q   <= src_q + 32'd4;
+
+            if (batch_last_w)
+            begin
+                count_q <= {(BUF_W+1){1'b0}};
+                state_q <= STATE_WRITE;
+            end
+            else
+                count_q <= count_q + 1;
+        end
+    end
+    //-----------------------------------------
+    // WRITE - Copy batch out of u_buf
+    //-----------------------------------------
+    STATE_WRITE :
+    begin
+        if (eng_issue_w)
+        begin
+            dst_q    <= dst_q + 32'd4;
+            remain_q <= remain_q - 32'd1;
+
+            if (batch_last_w)
+            begin
+                count_q <= {(BUF_W+1){1'b0}};
+                batch_q <= {(BUF_W+1){1'b0}};
+
+                if (job_last_w)
+                    state_q <= STATE_FLUSH;
+                else
+                begin
+                    state_q <= STATE_READ;
+                    yield_q <= in_req_w;
+                end
+            end
+            else
+                count_q <= count_q + 1;
+        end
+    end
+    //-----------------------------------------
+    // FLUSH - Wait for the last writes
+    //-----------------------------------------
+    STATE_FLUSH :
+    begin
+        if (outstanding_q == {(OUT_W+1){1'b0}})
+        begin
+            done_q  <= 1'b1;
+            state_q <= STATE_IDLE;
+        end
+    end
+    default :
+        state_q <= STATE_IDLE;
+    endcase
+end
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+    outstanding_q <= {(OUT_W+1){1'b0}};
+else if (eng_issue_w && !eng_ack_w)
+    outstanding_q <= outstanding_q + 1;
+else if (!eng_issue_w && eng_ack_w)
+    outstanding_q <= outstanding_q - 1;
+
+//-----------------------------------------------------------------
+// Request mux
+//-----------------------------------------------------------------
+assign outport_rd_o         = eng_sel_w ? eng_rd_w : (inport_rd_i && owner_accept_w);
+assign outport_wr_o         = eng_sel_w ? (eng_wr_w ? 4'hF : 4'b0) :
+                              owner_accept_w ? inport_wr_i : 4'b0;
+assign outport_len_o        = eng_sel_w ? 8'd0 : inport_len_i;
+assign outport_addr_o       = !eng_sel_w ? inport_addr_i :
+                              (state_q == STATE_READ) ? src_q : dst_q;
+assign outport_write_data_o = !eng_sel_w ? inport_write_data_i :
+                              (state_q == STATE_FILL) ? fill_q : buf_data_w;
+
+assign inport_accept_o      = !eng_sel_w && outport_accept_i && owner_accept_w;
+
+always @ (posedge clk_i or posedge rst_i)
+if (rst_i)
+begin
+    owner_hold_q     <= 1'b0;
+    owner_hold_eng_q <= 1'b0;
+end
+else if ((outport_rd_o || (outport_wr_o != 4'b0)) && !outport_accept_i)
+begin
+    owner_hold_q     <= 1'b1;
+    owner_hold_eng_q <= eng_sel_w;
+end
+else if (outport_accept_i)
+    owner_hold_q     <= 1'b0;
+
+//-----------------------------------------------------------------
+// Response routing: {engine, read}
+//-----------------------------------------------------------------
+sdram_axi_pmem_fifo2
+#(
+     .WIDTH(2)
+    ,.DEPTH(OWNER_DEPTH)
+    ,.ADDR_W(OWNER_W)
+)
+u_owner
+(
+    .clk_i(clk_i),
+    .rst_i(rst_i),
+
+    // Input
+    .data_in_i({eng_sel_w, outport_rd_o}),
+    .push_i((outport_rd_o || (outport_wr_o != 4'b0)) && outport_accept_i),
+    .accept_o(owner_accept_w),
+
+    // Output
+    .pop_i(outport_ack_i),
+    .data_out_o(owner_w),
+    .valid_o()
+);
+
+assign inport_ack_o       = outport_ack_i && !owner_w[1];
+assign inport_error_o     = outport_error_i;
+assign inport_read_data_o = outport_read_data_i;
+
+//-----------------------------------------------------------------
+// Copy buffer (one batch, empty at the start of each batch)
+//-----------------------------------------------------------------
+sdram_axi_pmem_fifo2
+#(
+     .WIDTH(32)
+    ,.DEPTH(XFER_BUF_DEPTH)
+    ,.ADDR_W(BUF_W)
+)
+u_buf
+(
+    .clk_i(clk_i),
+    .rst_i(rst_i),
+
+    // Input
+    .data_in_i(outport_read_data_i),
+    .push_i(eng_ack_w && owner_w[0]),
+    .accept_o(),
+
+    // Output
+    .pop_i(eng_issue_w && (state_q == STATE_WRITE)),
+    .data_out_o(buf_data_w),
+    .valid_o(buf_valid_w)
+);
+
+assign xfer_busy_o = (state_q != STATE_IDLE);
+assign xfer_done_o = done_q;
+
+endmodule
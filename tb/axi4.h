@@ -9,23 +9,23 @@
 class axi4_master
 {
 public:
-    // Members
-    sc_uint <1> AWVALID;
-    sc_uint <32> AWADDR;
-    sc_uint <4> AWID;
-    sc_uint <8> AWLEN;
-    sc_uint <2> AWBURST;
-    sc_uint <1> WVALID;
-    sc_uint <32> WDATA;
-    sc_uint <4> WSTRB;
-    sc_uint <1> WLAST;
-    sc_uint <1> BREADY;
-    sc_uint <1> ARVALID;
-    sc_uint <32> ARADDR;
-    sc_uint <4> ARID;
-    sc_uint <8> ARLEN;
-    sc_uint <2> ARBURST;
-    sc_uint <1> RREADY;
+    // Members (native integers: cheap copy / compare per signal update)
+    bool     AWVALID;
+    uint32_t AWADDR;
+    uint8_t  AWID;
+    uint8_t  AWLEN;
+    uint8_t  AWBURST;
+    bool     WVALID;
+    uint32_t WDATA;
+    uint8_t  WSTRB;
+    bool     WLAST;
+    bool     BREADY;
+    bool     ARVALID;
+    uint32_t ARADDR;
+    uint8_t  ARID;
+    uint8_t  ARLEN;
+    uint8_t  ARBURST;
+    bool     RREADY;
 
     // Construction
     axi4_master() { init(); }
@@ -75,41 +75,41 @@ public:
     friend void sc_trace(sc_trace_file *tf, const axi4_master & v, const std::string & path)
     {
         sc_trace(tf,v.AWVALID, path + "/awvalid");
-        sc_trace(tf,v.AWADDR, path + "/awaddr");
-        sc_trace(tf,v.AWID, path + "/awid");
-        sc_trace(tf,v.AWLEN, path + "/awlen");
-        sc_trace(tf,v.AWBURST, path + "/awburst");
+        sc_trace(tf,v.AWADDR, path + "/awaddr", 32);
+        sc_trace(tf,v.AWID, path + "/awid", 4);
+        sc_trace(tf,v.AWLEN, path + "/awlen", 8);
+        sc_trace(tf,v.AWBURST, path + "/awburst", 2);
         sc_trace(tf,v.WVALID, path + "/wvalid");
-        sc_trace(tf,v.WDATA, path + "/wdata");
-        sc_trace(tf,v.WSTRB, path + "/wstrb");
+        sc_trace(tf,v.WDATA, path + "/wdata", 32);
+        sc_trace(tf,v.WSTRB, path + "/wstrb", 4);
         sc_trace(tf,v.WLAST, path + "/wlast");
         sc_trace(tf,v.BREADY, path + "/bready");
         sc_trace(tf,v.ARVALID, path + "/arvalid");
-        sc_trace(tf,v.ARADDR, path + "/araddr");
-        sc_trace(tf,v.ARID, path + "/arid");
-        sc_trace(tf,v.ARLEN, path + "/arlen");
-        sc_trace(tf,v.ARBURST, path + "/arburst");
+        sc_trace(tf,v.ARADDR, path + "/araddr", 32);
+        sc_trace(tf,v.ARID, path + "/arid", 4);
+        sc_trace(tf,v.ARLEN, path + "/arlen", 8);
+        sc_trace(tf,v.ARBURST, path + "/arburst", 2);
         sc_trace(tf,v.RREADY, path + "/rready");
     }
 
     friend ostream& operator << (ostream& os, axi4_master const & v)
     {
-        os << hex << "AWVALID: " << v.AWVALID << " ";
-        os << hex << "AWADDR: " << v.AWADDR << " ";
-        os << hex << "AWID: " << v.AWID << " ";
-        os << hex << "AWLEN: " << v.AWLEN << " ";
-        os << hex << "AWBURST: " << v.AWBURST << " ";
-        os << hex << "WVALID: " << v.WVALID << " ";
-        os << hex << "WDATA: " << v.WDATA << " ";
-        os << hex << "WSTRB: " << v.WSTRB << " ";
-        os << hex << "WLAST: " << v.WLAST << " ";
-        os << hex << "BREADY: " << v.BREADY << " ";
-        os << hex << "ARVALID: " << v.ARVALID << " ";
-        os << hex << "ARADDR: " << v.ARADDR << " ";
-        os << hex << "ARID: " << v.ARID << " ";
-        os << hex << "ARLEN: " << v.ARLEN << " ";
-        os << hex << "ARBURST: " << v.ARBURST << " ";
-        os << hex << "RREADY: " << v.RREADY << " ";
+        os << hex << "AWVALID: " << (unsigned)v.AWVALID << " ";
+        os << hex << "AWADDR: " << (unsigned)v.AWADDR << " ";
+        os << hex << "AWID: " << (unsigned)v.AWID << " ";
+        os << hex << "AWLEN: " << (unsigned)v.AWLEN << " ";
+        os << hex << "AWBURST: " << (unsigned)v.AWBURST << " ";
+        os << hex << "WVALID: " << (unsigned)v.WVALID << " ";
+        os << hex << "WDATA: " << (unsigned)v.WDATA << " ";
+        os << hex << "WSTRB: " << (unsigned)v.WSTRB << " ";
+        os << hex << "WLAST: " << (unsigned)v.WLAST << " ";
+        os << hex << "BREADY: " << (unsigned)v.BREADY << " ";
+        os << hex << "ARVALID: " << (unsigned)v.ARVALID << " ";
+        os << hex << "ARADDR: " << (unsigned)v.ARADDR << " ";
+        os << hex << "ARID: " << (unsigned)v.ARID << " ";
+        os << hex << "ARLEN: " << (unsigned)v.ARLEN << " ";
+        os << hex << "ARBURST: " << (unsigned)v.ARBURST << " ";
+        os << hex << "RREADY: " << (unsigned)v.RREADY << " ";
         return os;
     }
 
@@ -145,18 +145,18 @@ public:
 class axi4_slave
 {
 public:
-    // Members
-    sc_uint <1> AWREADY;
-    sc_uint <1> WREADY;
-    sc_uint <1> BVALID;
-    sc_uint <2> BRESP;
-    sc_uint <4> BID;
-    sc_uint <1> ARREADY;
-    sc_uint <1> RVALID;
-    sc_uint <32> RDATA;
-    sc_uint <2> RRESP;
-    sc_uint <4> RID;
-    sc_uint <1> RLAST;
+    // Members (native integers: cheap copy / compare per signal update)
+    bool     AWREADY;
+    bool     WREADY;
+    bool     BVALID;
+    uint8_t  BRESP;
+    uint8_t  BID;
+    bool     ARREADY;
+    bool     RVALID;
+    uint32_t RDATA;
+    uint8_t  RRESP;
+    uint8_t  RID;
+    bool     RLAST;
 
     // Construction
     axi4_slave() { init(); }
@@ -198,29 +198,29 @@ public:
         sc_trace(tf,v.AWREADY, path + "/awready");
         sc_trace(tf,v.WREADY, path + "/wready");
         sc_trace(tf,v.BVALID, path + "/bvalid");
-        sc_trace(tf,v.BRESP, path + "/bresp");
-        sc_trace(tf,v.BID, path + "/bid");
+        sc_trace(tf,v.BRESP, path + "/bresp", 2);
+        sc_trace(tf,v.BID, path + "/bid", 4);
         sc_trace(tf,v.ARREADY, path + "/arready");
         sc_trace(tf,v.RVALID, path + "/rvalid");
-        sc_trace(tf,v.RDATA, path + "/rdata");
-        sc_trace(tf,v.RRESP, path + "/rresp");
-        sc_trace(tf,v.RID, path + "/rid");
+        sc_trace(tf,v.RDATA, path + "/rdata", 32);
+        sc_trace(tf,v.RRESP, path + "/rresp", 2);
+        sc_trace(tf,v.RID, path + "/rid", 4);
         sc_trace(tf,v.RLAST, path + "/rlast");
     }
 
     friend ostream& operator << (ostream& os, axi4_slave const & v)
     {
-        os << hex << "AWREADY: " << v.AWREADY << " ";
-        os << hex << "WREADY: " << v.WREADY << " ";
-        os << hex << "BVALID: " << v.BVALID << " ";
-        os << hex << "BRESP: " << v.BRESP << " ";
-        os << hex << "BID: " << v.BID << " ";
-        os << hex << "ARREADY: " << v.ARREADY << " ";
-        os << hex << "RVALID: " << v.RVALID << " ";
-        os << hex << "RDATA: " << v.RDATA << " ";
-        os << hex << "RRESP: " << v.RRESP << " ";
-        os << hex << "RID: " << v.RID << " ";
-        os << hex << "RLAST: " << v.RLAST << " ";
+        os << hex << "AWREADY: " << (unsigned)v.AWREADY << " ";
+        os << hex << "WREADY: " << (unsigned)v.WREADY << " ";
+        os << hex << "BVALID: " << (unsigned)v.BVALID << " ";
+        os << hex << "BRESP: " << (unsigned)v.BRESP << " ";
+        os << hex << "BID: " << (unsigned)v.BID << " ";
+        os << hex << "ARREADY: " << (unsigned)v.ARREADY << " ";
+        os << hex << "RVALID: " << (unsigned)v.RVALID << " ";
+        os << hex << "RDATA: " << (unsigned)v.RDATA << " ";
+        os << hex << "RRESP: " << (unsigned)v.RRESP << " ";
+        os << hex << "RID: " << (unsigned)v.RID << " ";
+        os << hex << "RLAST: " << (unsigned)v.RLAST << " ";
         return os;
     }
 
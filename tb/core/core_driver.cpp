@@ -0,0 +1,144 @@
+#include "core_driver.h"
+#include <stdio.h>
+
+//-----------------------------------------------------------------
+// Constructor
+//-----------------------------------------------------------------
+core_driver::core_driver(Vsdram_axi_core *rtl, sdram_core_mem *mem, uint8_t *shadow, uint32_t shadow_size)
+{
+    m_rtl         = rtl;
+    m_mem         = mem;
+    m_shadow      = shadow;
+    m_shadow_size = shadow_size;
+    m_cycle       = 0;
+    m_req_valid   = false;
+
+    reset_stats();
+}
+//-----------------------------------------------------------------
+// reset_stats
+//-----------------------------------------------------------------
+void core_driver::reset_stats(void)
+{
+    m_completed     = 0;
+    m_latency_total = 0;
+    m_latency_max   = 0;
+    m_mismatches    = 0;
+}
+//-----------------------------------------------------------------
+// reset: Hold reset for a number of cycles
+//-----------------------------------------------------------------
+void core_driver::reset(int cycles)
+{
+    m_rtl->rst_i = 1;
+    drive_inputs();
+
+    for (int i=0;i<cycles;i++)
+        tick();
+
+    m_rtl->rst_i = 0;
+    m_rtl->eval();
+}
+//-----------------------------------------------------------------
+// request: Present a new request to the core
+//-----------------------------------------------------------------
+bool core_driver::request(bool write, uint32_t addr, uint32_t data, uint8_t strb)
+{
+    if (m_req_valid)
+        return false;
+
+    m_req.write = write;
+    m_req.addr  = addr;
+    m_req.data  = data;
+    m_req.strb  = strb;
+    m_req.issue = m_cycle;
+    m_req_valid = true;
+
+    // Core processes requests in order: reads see all earlier writes
+    m_req.expected = 0;
+    for (int i=0;i<4;i++)
+    {
+        if (write && (strb & (1 << i)))
+            m_shadow[(addr + i) % m_shadow_size] = data >> (i * 8);
+        else if (!write)
+            m_req.expected |= ((uint32_t)m_shadow[(addr + i) % m_shadow_size]) << (i * 8);
+    }
+
+    drive_inputs();
+    return true;
+}
+//-----------------------------------------------------------------
+// drive_inputs: Inport from the current request
+//-----------------------------------------------------------------
+void core_driver::drive_inputs(void)
+{
+    m_rtl->inport_rd_i         = m_req_valid && !m_req.write;
+    m_rtl->inport_wr_i         = (m_req_valid && m_req.write) ? m_req.strb : 0;
+    m_rtl->inport_len_i        = 0;
+    m_rtl->inport_addr_i       = m_req.addr;
+    m_rtl->inport_write_data_i = m_req.data;
+    m_rtl->eval();
+}
+//-----------------------------------------------------------------
+// tick: Sample outputs, rising edge, update inputs, falling edge
+//-----------------------------------------------------------------
+void core_driver::tick(void)
+{
+    // Pins / handshakes as seen just before the edge
+    sdram_core_pins pins;
+    pins.cs       = m_rtl->sdram_cs_o;
+    pins.ras      = m_rtl->sdram_ras_o;
+    pins.cas      = m_rtl->sdram_cas_o;
+    pins.we       = m_rtl->sdram_we_o;
+    pins.dqm      = m_rtl->sdram_dqm_o;
+    pins.addr     = m_rtl->sdram_addr_o;
+    pins.ba       = m_rtl->sdram_ba_o;
+    pins.data_out = m_rtl->sdram_data_output_o;
+
+    bool     accept = m_req_valid && m_rtl->inport_accept_o;
+    bool     ack    = m_rtl->inport_ack_o;
+    uint32_t rdata  = m_rtl->inport_read_data_o;
+
+    uint16_t data_in = m_mem->step(pins);
+
+    m_rtl->clk_i = 1;
+    m_rtl->eval();
+    m_cycle++;
+
+    m_rtl->sdram_data_input_i = data_in;
+
+    if (accept)
+    {
+        m_outstanding.push_back(m_req);
+        m_req_valid = false;
+    }
+
+    if (ack)
+    {
+        if (m_outstanding.empty())
+        {
+            printf("ERROR: Unexpected ack @ %llu\n", (unsigned long long)m_cycle);
+            m_mismatches++;
+        }
+        else
+        {
+            core_req req = m_outstanding.front();
+            m_outstanding.pop_front();
+
+            if (!req.write && rdata != req.expected)
+            {
+                printf("MISMATCH: %08x -> %08x != %08x\n", req.addr, rdata, req.expected);
+                m_mismatches++;
+            }
+
+            uint64_t latency = m_cycle - req.issue;
+            m_latency_total += latency;
+            if (latency > m_latency_max)
+                m_latency_max = latency;
+            m_completed++;
+        }
+    }
+
+    m_rtl->clk_i = 0;
+    drive_inputs();
+}
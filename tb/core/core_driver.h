@@ -0,0 +1,72 @@
+#ifndef CORE_DRIVER_H
+#define CORE_DRIVER_H
+
+#include <stdint.h>
+#include <deque>
+#include "Vsdram_axi_core.h"
+#include "sdram_core_mem.h"
+
+//-------------------------------------------------------------
+// core_req: Single 32-bit request on the core inport
+//-------------------------------------------------------------
+typedef struct core_req_s
+{
+    bool     write;
+    uint32_t addr;
+    uint32_t data;
+    uint8_t  strb;
+    uint32_t expected;  // Read data (shadow at request time)
+    uint64_t issue;     // Cycle first presented
+} core_req;
+
+//-------------------------------------------------------------
+// core_driver: Drives sdram_axi_core directly (no SystemC)
+//
+// One eval per clock edge on the verilated model with native
+// integer ports. The SDRAM side is closed by sdram_core_mem.
+//-------------------------------------------------------------
+class core_driver
+{
+public:
+    core_driver(Vsdram_axi_core *rtl, sdram_core_mem *mem, uint8_t *shadow, uint32_t shadow_size);
+
+    void         reset(int cycles = 4);
+
+    // Present a request (held until accepted), false if one is pending
+    bool         request(bool write, uint32_t addr, uint32_t data = 0, uint8_t strb = 0xF);
+    bool         busy(void)    { return m_req_valid; }
+    bool         idle(void)    { return !m_req_valid && m_outstanding.empty(); }
+
+    // Advance one clock cycle
+    void         tick(void);
+
+    uint64_t     cycle(void)   { return m_cycle; }
+
+    // Statistics
+    void         reset_stats(void);
+    uint64_t     completed(void)   { return m_completed; }
+    double       latency_mean(void){ return m_completed ? (double)m_latency_total / m_completed : 0.0; }
+    uint64_t     latency_max(void) { return m_latency_max; }
+    uint64_t     mismatches(void)  { return m_mismatches; }
+
+protected:
+    void         drive_inputs(void);
+
+protected:
+    Vsdram_axi_core *    m_rtl;
+    sdram_core_mem *     m_mem;
+    uint8_t *            m_shadow;
+    uint32_t             m_shadow_size;
+
+    uint64_t             m_cycle;
+    bool                 m_req_valid;
+    core_req             m_req;
+    std::deque<core_req> m_outstanding;
+
+    uint64_t             m_completed;
+    uint64_t             m_latency_total;
+    uint64_t             m_latency_max;
+    uint64_t             m_mismatches;
+};
+
+#endif
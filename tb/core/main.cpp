@@ -0,0 +1,159 @@
+#include "Vsdram_axi_core.h"
+#include "verilated.h"
+#include "core_driver.h"
+#include "sdram_core_mem.h"
+#include "sdram_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/time.h>
+
+//--------------------------------------------------------------------
+// Defines
+//--------------------------------------------------------------------
+#define MEM_SIZE           (512 * 1024)
+#define MIXED_WRITE_RATIO  3     // 1 in 3 accesses are writes
+
+//--------------------------------------------------------------------
+// Benchmarks (32-bit accesses straight onto the core inport)
+//--------------------------------------------------------------------
+static const char *bench_names[] =
+{
+    "seq_read",
+    "seq_write",
+    "random_read",
+    "random_write",
+    "mixed_rw",
+    NULL
+};
+
+// Required by verilated.cpp when not using SystemC
+double sc_time_stamp(void) { return 0; }
+
+//--------------------------------------------------------------------
+// wall_time
+//--------------------------------------------------------------------
+static double wall_time(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + (tv.tv_usec / 1000000.0);
+}
+//--------------------------------------------------------------------
+// run_bench: Issue ops requests back-to-back, wait for completion
+//--------------------------------------------------------------------
+static void run_bench(core_driver *drv, int idx, int ops)
+{
+    uint64_t start = drv->cycle();
+    double   wall  = wall_time();
+    int      issued = 0;
+
+    drv->reset_stats();
+
+    while (issued < ops || !drv->idle())
+    {
+        if (issued < ops && !drv->busy())
+        {
+            uint32_t seq  = (issued * 4) % MEM_SIZE;
+            uint32_t rnd  = (rand() % MEM_SIZE) & ~3;
+            uint32_t data = rand();
+
+            switch (idx)
+            {
+                case 0: drv->request(false, seq); break;
+                case 1: drv->request(true,  seq, data); break;
+                case 2: drv->request(false, rnd); break;
+                case 3: drv->request(true,  rnd, data); break;
+                case 4: drv->request((rand() % MIXED_WRITE_RATIO) == 0, rnd, data); break;
+            }
+            issued++;
+        }
+
+        drv->tick();
+    }
+
+    uint64_t cycles = drv->cycle() - start;
+    wall = wall_time() - wall;
+
+    printf("PERF: name=core_%s txns=%llu cycles=%llu util=%.3f lat_mean=%.2f lat_max=%llu mismatch=%llu\n",
+            bench_names[idx],
+            (unsigned long long)drv->completed(),
+            (unsigned long long)cycles,
+            cycles ? (double)drv->completed() / cycles : 0.0,
+            drv->latency_mean(),
+            (unsigned long long)drv->latency_max(),
+            (unsigned long long)drv->mismatches());
+
+    printf("SPEED: cycles=%llu wall_s=%.3f cycles_per_sec=%.0f\n",
+            (unsigned long long)cycles, wall, wall > 0 ? cycles / wall : 0.0);
+}
+//--------------------------------------------------------------------
+// main
+//--------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    std::string bench = "all";
+    int         ops   = 100000;
+    int         seed  = 1;
+    bool        found = false;
+    int         fails = 0;
+
+    Verilated::commandArgs(argc, argv);
+
+    for (int i=1;i<argc;i++)
+    {
+        if (!strcmp(argv[i], "--bench") && (i+1) < argc)
+            bench = argv[++i];
+        else if (!strcmp(argv[i], "--ops") && (i+1) < argc)
+            ops = strtol(argv[++i], NULL, 0);
+        else if (!strcmp(argv[i], "--seed") && (i+1) < argc)
+            seed = strtol(argv[++i], NULL, 0);
+    }
+
+    srand(seed);
+
+    Vsdram_axi_core *rtl    = new Vsdram_axi_core;
+    sdram_core_mem  *mem    = new sdram_core_mem(SDRAM_ADDR_W, SDRAM_COL_W, SDRAM_MHZ);
+    uint8_t         *shadow = new uint8_t[MEM_SIZE];
+    memset(shadow, 0, MEM_SIZE);
+
+    core_driver *drv = new core_driver(rtl, mem, shadow, MEM_SIZE);
+    drv->reset();
+
+    // Wait out SDRAM initialisation (first access completes after it)
+    drv->request(false, 0);
+    while (!drv->idle())
+        drv->tick();
+
+    for (int i=0;bench_names[i];i++)
+    {
+        if (bench == "all" || bench == bench_names[i])
+        {
+            run_bench(drv, i, ops);
+            fails += drv->mismatches() ? 1 : 0;
+            found  = true;
+        }
+    }
+
+    if (!found)
+    {
+        printf("ERROR: Unknown benchmark %s\n", bench.c_str());
+        return 1;
+    }
+
+    mem->print_stats();
+    rtl->final();
+
+    if (mem->timing_violations())
+        fails++;
+
+    if (fails)
+    {
+        printf("TEST FAILED\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,222 @@
+#include "sdram_core_mem.h"
+#include <stdio.h>
+#include <assert.h>
+
+//-----------------------------------------------------------------
+// Constructor
+//-----------------------------------------------------------------
+sdram_core_mem::sdram_core_mem(int addr_w, int col_w, int sdram_mhz)
+{
+    m_col_w = col_w;
+    m_mem.resize(1 << (addr_w + 1));
+
+    m_configured     = false;
+    m_burst_length   = 1;
+    m_write_burst_en = false;
+    m_cas_latency    = 2;
+
+    for (int b=0;b<NUM_BANKS;b++)
+    {
+        m_active_row[b]      = -1;
+        m_burst_close_row[b] = false;
+    }
+
+    m_burst_write  = 0;
+    m_burst_read   = 0;
+    m_burst_offset = 0;
+    m_addr         = 0;
+    m_bank         = 0;
+
+    for (int i=0;i<3;i++)
+        m_resp_data[i] = 0;
+
+    m_cycles    = 0;
+    m_data_busy = 0;
+    m_activates = 0;
+    m_refreshes = 0;
+
+    m_timing.configure(sdram_speed_grade_find(SDRAM_SPEED_GRADE), sdram_mhz, addr_w - col_w - SDRAM_BANK_W, NUM_BANKS);
+}
+//-----------------------------------------------------------------
+// map_addr: Address = RBC
+//-----------------------------------------------------------------
+uint32_t sdram_core_mem::map_addr(uint32_t row, uint32_t bank, uint32_t col)
+{
+    uint32_t col_mask = (1 << m_col_w) - 1;
+
+    return (((col & col_mask) >> 1) << 2) |
+           (bank << (m_col_w + 1)) |
+           (row  << (m_col_w + SDRAM_BANK_W + 1));
+}
+//-----------------------------------------------------------------
+// write_beat: Write 16-bits at the current burst position
+//-----------------------------------------------------------------
+void sdram_core_mem::write_beat(uint16_t data, uint8_t dqm)
+{
+    uint8_t strb = 0;
+
+    if (!(dqm & 1)) strb |= 1 << (m_burst_offset + 0);
+    if (!(dqm & 2)) strb |= 1 << (m_burst_offset + 1);
+
+    write32(m_addr, ((uint32_t)data) << (m_burst_offset * 8), strb);
+    m_burst_offset += 2;
+}
+//-----------------------------------------------------------------
+// step: One clock edge
+//-----------------------------------------------------------------
+uint16_t sdram_core_mem::step(const sdram_core_pins &pins)
+{
+    bool nop = false;
+
+    m_cycles++;
+
+    m_timing.check(sdram_timing_checker::decode(pins.cs, pins.ras, pins.cas, pins.we), pins.ba, pins.addr);
+
+    if (!pins.cs)
+    {
+        int cmd = (pins.ras << 2) | (pins.cas << 1) | pins.we;
+
+        switch (cmd)
+        {
+            // NOP
+            case 7:
+                nop = true;
+                break;
+            // LOAD MODE
+            case 0:
+                m_configured     = true;
+                m_write_burst_en = !((pins.addr >> 9) & 1);
+                m_burst_length   = 1 << (pins.addr & 7);
+                m_cas_latency    = (pins.addr >> 4) & 7;
+                assert(((pins.addr >> 3) & 1) == 0);
+                break;
+            // REFRESH
+            case 1:
+                for (int b=0;b<NUM_BANKS;b++)
+                    assert(m_active_row[b] == -1);
+                m_refreshes++;
+                break;
+            // ACTIVE
+            case 3:
+                assert(m_configured);
+                assert(m_active_row[pins.ba] == -1);
+                m_active_row[pins.ba] = pins.addr;
+                m_activates++;
+                break;
+            // READ / WRITE
+            case 5:
+            case 4:
+            {
+                bool write = (cmd == 4);
+
+                assert(m_configured);
+                assert(m_active_row[pins.ba] != -1);
+
+                m_bank         = pins.ba;
+                m_addr         = map_addr(m_active_row[m_bank], m_bank, pins.addr);
+                m_burst_offset = 0;
+                m_data_busy++;
+
+                if (write)
+                {
+                    write_beat(pins.data_out, pins.dqm);
+                    m_burst_write = m_write_burst_en ? (m_burst_length - 1) : 0;
+                }
+                else
+                {
+                    assert(pins.dqm == 0);
+                    m_resp_data[m_cas_latency-2] = read32(m_addr) >> (m_burst_offset * 8);
+                    m_burst_offset += 2;
+                    m_burst_read    = m_burst_length - 1;
+                }
+
+                m_burst_close_row[m_bank] = (pins.addr >> 10) & 1;
+            }
+            break;
+            // PRECHARGE
+            case 2:
+                if ((pins.addr >> 10) & 1)
+                {
+                    for (int b=0;b<NUM_BANKS;b++)
+                        m_active_row[b] = -1;
+                }
+                else
+                    m_active_row[pins.ba] = -1;
+                break;
+            // BURST TERMINATE
+            case 6:
+                m_burst_write = 0;
+                m_burst_read  = 0;
+                break;
+        }
+    }
+
+    // Burst continuation
+    if (nop && (m_burst_write > 0 || m_burst_read > 0))
+    {
+        m_data_busy++;
+
+        if (m_burst_write > 0)
+        {
+            write_beat(pins.data_out, pins.dqm);
+            m_burst_write -= 1;
+        }
+        else
+        {
+            m_resp_data[m_cas_latency-2] = read32(m_addr) >> (m_burst_offset * 8);
+            m_burst_offset += 2;
+            m_burst_read   -= 1;
+        }
+
+        if (m_burst_offset == 4)
+        {
+            m_burst_offset = 0;
+            m_addr        += 4;
+        }
+
+        if (m_burst_write == 0 && m_burst_read == 0 && m_burst_close_row[m_bank])
+            m_active_row[m_bank] = -1;
+    }
+
+    uint16_t data_in = m_resp_data[0];
+
+    // Shuffle read data
+    for (int i=1;i<3;i++)
+        m_resp_data[i-1] = m_resp_data[i];
+
+    return data_in;
+}
+//-----------------------------------------------------------------
+// write32: Write a 32-bit word to memory
+//-----------------------------------------------------------------
+void sdram_core_mem::write32(uint32_t addr, uint32_t data, uint8_t strb)
+{
+    for (int i=0;i<4;i++)
+        if (strb & (1 << i))
+            m_mem[(addr + i) % m_mem.size()] = data >> (i*8);
+}
+//-----------------------------------------------------------------
+// read32: Read a 32-bit word from memory
+//-----------------------------------------------------------------
+uint32_t sdram_core_mem::read32(uint32_t addr)
+{
+    uint32_t data = 0;
+    for (int i=0;i<4;i++)
+        data |= ((uint32_t)m_mem[(addr + i) % m_mem.size()]) << (i*8);
+    return data;
+}
+//-----------------------------------------------------------------
+// print_stats
+//-----------------------------------------------------------------
+void sdram_core_mem::print_stats(void)
+{
+    printf("SDRAM: cycles=%llu active=%llu refresh=%llu data_busy=%llu data_util=%.3f\n",
+            (unsigned long long)m_cycles,
+            (unsigned long long)m_activates,
+            (unsigned long long)m_refreshes,
+            (unsigned long long)m_data_busy,
+            m_cycles ? (double)m_data_busy / m_cycles : 0.0);
+
+    m_timing.print_config();
+    printf("SDRAM: timing_violations=%llu\n", (unsigned long long)m_timing.violations());
+}
@@ -0,0 +1,82 @@
+#ifndef SDRAM_CORE_MEM_H
+#define SDRAM_CORE_MEM_H
+
+#include <stdint.h>
+#include <vector>
+#include "sdram_timing_checker.h"
+#include "sdram_config.h"
+
+//-------------------------------------------------------------
+// sdram_core_pins: SDRAM pins (native integers)
+//-------------------------------------------------------------
+typedef struct sdram_core_pins_s
+{
+    uint8_t  cs;
+    uint8_t  ras;
+    uint8_t  cas;
+    uint8_t  we;
+    uint8_t  dqm;
+    uint16_t addr;
+    uint8_t  ba;
+    uint16_t data_out;
+} sdram_core_pins;
+
+//-------------------------------------------------------------
+// sdram_core_mem: Cycle based SDRAM model (no SystemC)
+//
+// Same command decode, burst handling, CAS pipeline and RBC
+// address mapping as tb_sdram_mem.
+//-------------------------------------------------------------
+class sdram_core_mem
+{
+public:
+    sdram_core_mem(int addr_w = 24, int col_w = 9, int sdram_mhz = 50);
+
+    // Called once per rising edge with the pins driven before it,
+    // returns DATA_INPUT to present after the edge.
+    uint16_t     step(const sdram_core_pins &pins);
+
+    uint32_t     read32(uint32_t addr);
+    void         write32(uint32_t addr, uint32_t data, uint8_t strb = 0xF);
+    uint8_t     *get_array(void) { return &m_mem[0]; }
+    uint32_t     get_size(void)  { return m_mem.size(); }
+
+    // Statistics
+    uint64_t     cycles(void)    { return m_cycles; }
+    uint64_t     data_busy(void) { return m_data_busy; }
+    uint64_t     timing_violations(void) { return m_timing.violations(); }
+    void         print_stats(void);
+
+protected:
+    uint32_t     map_addr(uint32_t row, uint32_t bank, uint32_t col);
+    void         write_beat(uint16_t data, uint8_t dqm);
+
+protected:
+    static const int NUM_BANKS = 1 << SDRAM_BANK_W;
+
+    int          m_col_w;
+    std::vector <uint8_t> m_mem;
+
+    bool         m_configured;
+    int          m_burst_length;
+    bool         m_write_burst_en;
+    int          m_cas_latency;
+
+    int          m_active_row[NUM_BANKS];
+    bool         m_burst_close_row[NUM_BANKS];
+    int          m_burst_write;
+    int          m_burst_read;
+    int          m_burst_offset;
+    uint32_t     m_addr;
+    int          m_bank;
+    uint16_t     m_resp_data[3];
+
+    sdram_timing_checker m_timing;
+
+    uint64_t     m_cycles;
+    uint64_t     m_data_busy;
+    uint64_t     m_activates;
+    uint64_t     m_refreshes;
+};
+
+#endif
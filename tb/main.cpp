@@ -72,7 +72,7 @@ static void sigint_handler(int s)
 //--------------------------------------------------------------------
 int sc_main(int argc, char* argv[])
 {
-    int iterations        = 10000;
+    int iterations        = 50000;
     bool trace            = true;
     int seed              = 1;
     bool delays           = true;
@@ -153,6 +153,9 @@ int sc_main(int argc, char* argv[])
     tb = new testbench("tb");
     tb->CLK0_NAME(CLK0_NAME);
     tb->RST0_NAME(clk0_rst.rst);
+#ifdef CLK1_NAME
+    tb->CLK1_NAME(CLK1_NAME);
+#endif
 #ifdef RST1_NAME
     tb->RST1_NAME(clk1_rst.rst);
 #endif
@@ -161,6 +164,7 @@ int sc_main(int argc, char* argv[])
     tb->set_delays(delays);
     tb->set_testcase(testcase);
     tb->set_argcv(argc - last_argc, &argv[last_argc]);
+    tb->set_trace(trace);
 
     // Go!
     sc_start();
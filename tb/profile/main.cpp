@@ -0,0 +1,69 @@
+#include "sdram_profile.h"
+#include "sdram_config.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+//--------------------------------------------------------------------
+// sdram_profile: Print RTL parameters / testbench defines for a profile
+//
+//   sdram_profile.x --list          (and the build defaults)
+//   sdram_profile.x --params NAME   (-G options for verilator)
+//   sdram_profile.x --cflags NAME   (-D options for the testbench)
+//--------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    if (argc == 2 && !strcmp(argv[1], "--list"))
+    {
+        sdram_profile_list();
+
+        // Builds without PROFILE= (sdram_config.h)
+        printf("DEFAULT: grade=%s rows=%d cols=%d banks=%d ranks=%d mhz=%d\n",
+                SDRAM_SPEED_GRADE, 1 << SDRAM_ROW_W, 1 << SDRAM_COL_W, 1 << SDRAM_BANK_W, SDRAM_RANKS, SDRAM_MHZ);
+        return 0;
+    }
+
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: %s --list | --params NAME | --cflags NAME\n", argv[0]);
+        return 1;
+    }
+
+    const sdram_profile *p = sdram_profile_find(argv[2]);
+    if (!p)
+    {
+        fprintf(stderr, "ERROR: Unknown SDRAM profile %s\n", argv[2]);
+        return 1;
+    }
+
+    if (!sdram_profile_supported(p, false))
+    {
+        fprintf(stderr, "ERROR: SDRAM profile %s not supported by sdram_axi\n", argv[2]);
+        return 1;
+    }
+
+    if (strcmp(argv[1], "--params") && strcmp(argv[1], "--cflags"))
+    {
+        fprintf(stderr, "ERROR: Unknown option %s\n", argv[1]);
+        return 1;
+    }
+
+    const sdram_speed_grade *g = sdram_profile_grade(p);
+    const char *fmt = !strcmp(argv[1], "--params") ? "-G%s=%d " : "-D%s=%d ";
+
+    printf(fmt, "SDRAM_ADDR_W",  sdram_profile_addr_w(p));
+    printf(fmt, "SDRAM_COL_W",   p->col_w);
+    printf(fmt, "SDRAM_BANK_W",  p->bank_w);
+    printf(fmt, "SDRAM_TRCD_NS", (int)ceil(g->tRCD));
+    printf(fmt, "SDRAM_TRP_NS",  (int)ceil(g->tRP));
+    printf(fmt, "SDRAM_TRFC_NS", (int)ceil(g->tRFC));
+    printf(fmt, "SDRAM_TWR_NS",  (int)ceil(g->tWR));
+    printf(fmt, "SDRAM_TRAS_NS", (int)ceil(g->tRAS));
+    printf(fmt, "SDRAM_TRRD_NS", (int)ceil(g->tRRD));
+    if (strcmp(argv[1], "--params"))
+        printf(fmt, "SDRAM_ROW_W", p->row_w);
+    printf("\n");
+
+    return 0;
+}
@@ -4,8 +4,16 @@
 
 #if VM_TRACE
 #include "verilated.h"
+#if VM_TRACE_FST
+#include "verilated_fst_sc.h"
+#else
 #include "verilated_vcd_sc.h"
 #endif
+#endif
+
+#if VM_SAVABLE
+#include "verilated_save.h"
+#endif
 
 //-------------------------------------------------------------
 // Constructor
@@ -15,6 +23,10 @@ sdram_axi::sdram_axi(sc_module_name name): sc_module(name)
     m_rtl = new Vsdram_axi("Vsdram_axi");
     m_rtl->clk_i(m_clk_in);
     m_rtl->rst_i(m_rst_in);
+#ifdef SDRAM_AXI_ASYNC
+    m_rtl->sdram_clk_i(m_sdram_clk_in);
+    m_rtl->sdram_rst_i(m_sdram_rst_in);
+#endif
     m_rtl->inport_awvalid_i(m_inport_awvalid_in);
     m_rtl->inport_awaddr_i(m_inport_awaddr_in);
     m_rtl->inport_awid_i(m_inport_awid_in);
@@ -54,10 +66,47 @@ sdram_axi::sdram_axi(sc_module_name name): sc_module(name)
     m_rtl->sdram_ba_o(m_sdram_ba_out);
     m_rtl->sdram_data_output_o(m_sdram_data_output_out);
     m_rtl->sdram_data_out_en_o(m_sdram_data_out_en_out);
+#ifdef SDRAM_AXI_DUAL
+    m_rtl->sdram1_data_input_i(m_sdram1_data_input_in);
+    m_rtl->sdram1_clk_o(m_sdram1_clk_out);
+    m_rtl->sdram1_cke_o(m_sdram1_cke_out);
+    m_rtl->sdram1_cs_o(m_sdram1_cs_out);
+    m_rtl->sdram1_ras_o(m_sdram1_ras_out);
+    m_rtl->sdram1_cas_o(m_sdram1_cas_out);
+    m_rtl->sdram1_we_o(m_sdram1_we_out);
+    m_rtl->sdram1_dqm_o(m_sdram1_dqm_out);
+    m_rtl->sdram1_addr_o(m_sdram1_addr_out);
+    m_rtl->sdram1_ba_o(m_sdram1_ba_out);
+    m_rtl->sdram1_data_output_o(m_sdram1_data_output_out);
+    m_rtl->sdram1_data_out_en_o(m_sdram1_data_out_en_out);
+#endif
+#ifdef SDRAM_AXI_STREAM
+    m_rtl->stream_start_i(m_stream_start_in);
+    m_rtl->stream_addr_i(m_stream_addr_in);
+    m_rtl->stream_len_i(m_stream_len_in);
+    m_rtl->stream_ready_i(m_stream_ready_in);
+    m_rtl->stream_valid_o(m_stream_valid_out);
+    m_rtl->stream_data_o(m_stream_data_out);
+    m_rtl->stream_busy_o(m_stream_busy_out);
+#endif
+#ifdef SDRAM_AXI_XFER
+    m_rtl->xfer_start_i(m_xfer_start_in);
+    m_rtl->xfer_copy_i(m_xfer_copy_in);
+    m_rtl->xfer_src_i(m_xfer_src_in);
+    m_rtl->xfer_dst_i(m_xfer_dst_in);
+    m_rtl->xfer_len_i(m_xfer_len_in);
+    m_rtl->xfer_fill_data_i(m_xfer_fill_data_in);
+    m_rtl->xfer_busy_o(m_xfer_busy_out);
+    m_rtl->xfer_done_o(m_xfer_done_out);
+#endif
 
     SC_METHOD(async_outputs);
     sensitive << clk_in;
     sensitive << rst_in;
+#ifdef SDRAM_AXI_ASYNC
+    sensitive << sdram_clk_in;
+    sensitive << sdram_rst_in;
+#endif
     sensitive << inport_in;
     sensitive << sdram_in;
     sensitive << m_inport_awready_out;
@@ -82,10 +131,42 @@ sdram_axi::sdram_axi(sc_module_name name): sc_module(name)
     sensitive << m_sdram_ba_out;
     sensitive << m_sdram_data_output_out;
     sensitive << m_sdram_data_out_en_out;
+#ifdef SDRAM_AXI_DUAL
+    sensitive << sdram1_in;
+    sensitive << m_sdram1_clk_out;
+    sensitive << m_sdram1_cke_out;
+    sensitive << m_sdram1_cs_out;
+    sensitive << m_sdram1_ras_out;
+    sensitive << m_sdram1_cas_out;
+    sensitive << m_sdram1_we_out;
+    sensitive << m_sdram1_dqm_out;
+    sensitive << m_sdram1_addr_out;
+    sensitive << m_sdram1_ba_out;
+    sensitive << m_sdram1_data_output_out;
+    sensitive << m_sdram1_data_out_en_out;
+#endif
+#ifdef SDRAM_AXI_STREAM
+    sensitive << stream_start_in;
+    sensitive << stream_addr_in;
+    sensitive << stream_len_in;
+    sensitive << stream_ready_in;
+    sensitive << m_stream_valid_out;
+    sensitive << m_stream_data_out;
+    sensitive << m_stream_busy_out;
+#endif
+#ifdef SDRAM_AXI_XFER
+    sensitive << xfer_start_in;
+    sensitive << xfer_copy_in;
+    sensitive << xfer_src_in;
+    sensitive << xfer_dst_in;
+    sensitive << xfer_len_in;
+    sensitive << xfer_fill_data_in;
+    sensitive << m_xfer_busy_out;
+    sensitive << m_xfer_done_out;
+#endif
 
 #if VM_TRACE
     m_vcd         = NULL;
-    m_delay_waves = false;
 #endif
 }
 //-------------------------------------------------------------
@@ -93,18 +174,35 @@ sdram_axi::sdram_axi(sc_module_name name): sc_module(name)
 //-------------------------------------------------------------
 void sdram_axi::trace_enable(VerilatedVcdSc * p)
 {
-#if VM_TRACE
+#if VM_TRACE && !VM_TRACE_FST
     m_vcd = p;
-    m_rtl->trace (m_vcd, 99);
+    m_rtl->trace (p, 99);
 #endif
 }
-void sdram_axi::trace_enable(VerilatedVcdSc *p, sc_core::sc_time start_time)
+void sdram_axi::trace_enable(VerilatedFstSc * p)
 {
-#if VM_TRACE
+#if VM_TRACE && VM_TRACE_FST
     m_vcd = p;
-    m_delay_waves = true;
-    m_waves_start = start_time;
-    //m_rtl->trace (m_vcd, 99);
+    m_rtl->trace (p, 99);
+#endif
+}
+//-------------------------------------------------------------
+// save / restore
+//-------------------------------------------------------------
+void sdram_axi::save(VerilatedSerialize &os)
+{
+#if VM_SAVABLE
+    os << *m_rtl;
+#else
+    sc_assert(!"Model not verilated with --savable");
+#endif
+}
+void sdram_axi::restore(VerilatedDeserialize &is)
+{
+#if VM_SAVABLE
+    is >> *m_rtl;
+#else
+    sc_assert(!"Model not verilated with --savable");
 #endif
 }
 //-------------------------------------------------------------
@@ -114,6 +212,10 @@ void sdram_axi::async_outputs(void)
 {
     m_clk_in.write(clk_in.read());
     m_rst_in.write(rst_in.read());
+#ifdef SDRAM_AXI_ASYNC
+    m_sdram_clk_in.write(sdram_clk_in.read());
+    m_sdram_rst_in.write(sdram_rst_in.read());
+#endif
 
     axi4_master inport_i = inport_in.read();
     m_inport_awvalid_in.write(inport_i.AWVALID); 
@@ -165,4 +267,44 @@ void sdram_axi::async_outputs(void)
     sdram_o.DATA_OUT_EN = m_sdram_data_out_en_out.read(); 
     sdram_out.write(sdram_o);
 
+#ifdef SDRAM_AXI_DUAL
+    sdram_io_slave sdram1_i = sdram1_in.read();
+    m_sdram1_data_input_in.write(sdram1_i.DATA_INPUT); 
+
+    sdram_io_master sdram1_o;
+    sdram1_o.CLK = m_sdram1_clk_out.read(); 
+    sdram1_o.CKE = m_sdram1_cke_out.read(); 
+    sdram1_o.CS = m_sdram1_cs_out.read(); 
+    sdram1_o.RAS = m_sdram1_ras_out.read(); 
+    sdram1_o.CAS = m_sdram1_cas_out.read(); 
+    sdram1_o.WE = m_sdram1_we_out.read(); 
+    sdram1_o.DQM = m_sdram1_dqm_out.read(); 
+    sdram1_o.ADDR = m_sdram1_addr_out.read(); 
+    sdram1_o.BA = m_sdram1_ba_out.read(); 
+    sdram1_o.DATA_OUTPUT = m_sdram1_data_output_out.read(); 
+    sdram1_o.DATA_OUT_EN = m_sdram1_data_out_en_out.read(); 
+    sdram1_out.write(sdram1_o);
+#endif
+
+#ifdef SDRAM_AXI_STREAM
+    m_stream_start_in.write(stream_start_in.read());
+    m_stream_addr_in.write(stream_addr_in.read());
+    m_stream_len_in.write(stream_len_in.read());
+    m_stream_ready_in.write(stream_ready_in.read());
+    stream_valid_out.write(m_stream_valid_out.read());
+    stream_data_out.write(m_stream_data_out.read());
+    stream_busy_out.write(m_stream_busy_out.read());
+#endif
+
+#ifdef SDRAM_AXI_XFER
+    m_xfer_start_in.write(xfer_start_in.read());
+    m_xfer_copy_in.write(xfer_copy_in.read());
+    m_xfer_src_in.write(xfer_src_in.read());
+    m_xfer_dst_in.write(xfer_dst_in.read());
+    m_xfer_len_in.write(xfer_len_in.read());
+    m_xfer_fill_data_in.write(xfer_fill_data_in.read());
+    xfer_busy_out.write(m_xfer_busy_out.read());
+    xfer_done_out.write(m_xfer_done_out.read());
+#endif
+
 }
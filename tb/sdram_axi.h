@@ -8,6 +8,9 @@
 
 class Vsdram_axi;
 class VerilatedVcdSc;
+class VerilatedFstSc;
+class VerilatedSerialize;
+class VerilatedDeserialize;
 
 //-------------------------------------------------------------
 // sdram_axi: RTL wrapper class
@@ -17,11 +20,38 @@ class sdram_axi: public sc_module
 public:
     sc_in <bool> clk_in;
     sc_in <bool> rst_in;
+#ifdef SDRAM_AXI_ASYNC
+    sc_in <bool> sdram_clk_in;
+    sc_in <bool> sdram_rst_in;
+#endif
 
     sc_in  <axi4_master>  inport_in;
     sc_out <axi4_slave> inport_out;
     sc_in  <sdram_io_slave>  sdram_in;
     sc_out <sdram_io_master> sdram_out;
+#ifdef SDRAM_AXI_DUAL
+    sc_in  <sdram_io_slave>  sdram1_in;
+    sc_out <sdram_io_master> sdram1_out;
+#endif
+#ifdef SDRAM_AXI_STREAM
+    sc_in  <bool>            stream_start_in;
+    sc_in  <sc_uint<32> >    stream_addr_in;
+    sc_in  <sc_uint<32> >    stream_len_in;
+    sc_in  <bool>            stream_ready_in;
+    sc_out <bool>            stream_valid_out;
+    sc_out <sc_uint<32> >    stream_data_out;
+    sc_out <bool>            stream_busy_out;
+#endif
+#ifdef SDRAM_AXI_XFER
+    sc_in  <bool>            xfer_start_in;
+    sc_in  <bool>            xfer_copy_in;
+    sc_in  <sc_uint<32> >    xfer_src_in;
+    sc_in  <sc_uint<32> >    xfer_dst_in;
+    sc_in  <sc_uint<32> >    xfer_len_in;
+    sc_in  <sc_uint<32> >    xfer_fill_data_in;
+    sc_out <bool>            xfer_busy_out;
+    sc_out <bool>            xfer_done_out;
+#endif
 
     //-------------------------------------------------------------
     // Constructor
@@ -39,10 +69,37 @@ public:
 
         TRACE_SIGNAL(clk_in);
         TRACE_SIGNAL(rst_in);
+#ifdef SDRAM_AXI_ASYNC
+        TRACE_SIGNAL(sdram_clk_in);
+        TRACE_SIGNAL(sdram_rst_in);
+#endif
         TRACE_SIGNAL(inport_in);
         TRACE_SIGNAL(inport_out);
         TRACE_SIGNAL(sdram_in);
         TRACE_SIGNAL(sdram_out);
+#ifdef SDRAM_AXI_DUAL
+        TRACE_SIGNAL(sdram1_in);
+        TRACE_SIGNAL(sdram1_out);
+#endif
+#ifdef SDRAM_AXI_STREAM
+        TRACE_SIGNAL(stream_start_in);
+        TRACE_SIGNAL(stream_addr_in);
+        TRACE_SIGNAL(stream_len_in);
+        TRACE_SIGNAL(stream_ready_in);
+        TRACE_SIGNAL(stream_valid_out);
+        TRACE_SIGNAL(stream_data_out);
+        TRACE_SIGNAL(stream_busy_out);
+#endif
+#ifdef SDRAM_AXI_XFER
+        TRACE_SIGNAL(xfer_start_in);
+        TRACE_SIGNAL(xfer_copy_in);
+        TRACE_SIGNAL(xfer_src_in);
+        TRACE_SIGNAL(xfer_dst_in);
+        TRACE_SIGNAL(xfer_len_in);
+        TRACE_SIGNAL(xfer_fill_data_in);
+        TRACE_SIGNAL(xfer_busy_out);
+        TRACE_SIGNAL(xfer_done_out);
+#endif
 
         #undef  TRACE_SIGNAL
     }
@@ -50,7 +107,11 @@ public:
     void async_outputs(void);
     void trace_rtl(void);
     void trace_enable(VerilatedVcdSc *p);
-    void trace_enable(VerilatedVcdSc *p, sc_core::sc_time start_time);
+    void trace_enable(VerilatedFstSc *p);
+
+    // Checkpoint of the verilated model state (requires --savable)
+    void save(VerilatedSerialize &os);
+    void restore(VerilatedDeserialize &is);
 
     //-------------------------------------------------------------
     // Signals
@@ -58,6 +119,10 @@ public:
 private:
     sc_signal <bool> m_clk_in;
     sc_signal <bool> m_rst_in;
+#ifdef SDRAM_AXI_ASYNC
+    sc_signal <bool> m_sdram_clk_in;
+    sc_signal <bool> m_sdram_rst_in;
+#endif
     sc_signal <bool> m_inport_awvalid_in;
     sc_signal <sc_uint<32> > m_inport_awaddr_in;
     sc_signal <sc_uint<4> > m_inport_awid_in;
@@ -89,22 +154,61 @@ private:
     sc_signal <bool> m_inport_rlast_out;
     sc_signal <bool> m_sdram_clk_out;
     sc_signal <bool> m_sdram_cke_out;
+#if SDRAM_RANK_W
+    sc_signal <sc_uint<SDRAM_RANKS> > m_sdram_cs_out;
+#else
     sc_signal <bool> m_sdram_cs_out;
+#endif
     sc_signal <bool> m_sdram_ras_out;
     sc_signal <bool> m_sdram_cas_out;
     sc_signal <bool> m_sdram_we_out;
     sc_signal <sc_uint<2> > m_sdram_dqm_out;
     sc_signal <sc_uint<13> > m_sdram_addr_out;
-    sc_signal <sc_uint<2> > m_sdram_ba_out;
+    sc_signal <sc_uint<SDRAM_BANK_W> > m_sdram_ba_out;
     sc_signal <sc_uint<16> > m_sdram_data_output_out;
     sc_signal <bool> m_sdram_data_out_en_out;
+#ifdef SDRAM_AXI_DUAL
+    sc_signal <sc_uint<16> > m_sdram1_data_input_in;
+    sc_signal <bool> m_sdram1_clk_out;
+    sc_signal <bool> m_sdram1_cke_out;
+#if SDRAM_RANK_W
+    sc_signal <sc_uint<SDRAM_RANKS> > m_sdram1_cs_out;
+#else
+    sc_signal <bool> m_sdram1_cs_out;
+#endif
+    sc_signal <bool> m_sdram1_ras_out;
+    sc_signal <bool> m_sdram1_cas_out;
+    sc_signal <bool> m_sdram1_we_out;
+    sc_signal <sc_uint<2> > m_sdram1_dqm_out;
+    sc_signal <sc_uint<13> > m_sdram1_addr_out;
+    sc_signal <sc_uint<SDRAM_BANK_W> > m_sdram1_ba_out;
+    sc_signal <sc_uint<16> > m_sdram1_data_output_out;
+    sc_signal <bool> m_sdram1_data_out_en_out;
+#endif
+#ifdef SDRAM_AXI_STREAM
+    sc_signal <bool> m_stream_start_in;
+    sc_signal <sc_uint<32> > m_stream_addr_in;
+    sc_signal <sc_uint<32> > m_stream_len_in;
+    sc_signal <bool> m_stream_ready_in;
+    sc_signal <bool> m_stream_valid_out;
+    sc_signal <sc_uint<32> > m_stream_data_out;
+    sc_signal <bool> m_stream_busy_out;
+#endif
+#ifdef SDRAM_AXI_XFER
+    sc_signal <bool> m_xfer_start_in;
+    sc_signal <bool> m_xfer_copy_in;
+    sc_signal <sc_uint<32> > m_xfer_src_in;
+    sc_signal <sc_uint<32> > m_xfer_dst_in;
+    sc_signal <sc_uint<32> > m_xfer_len_in;
+    sc_signal <sc_uint<32> > m_xfer_fill_data_in;
+    sc_signal <bool> m_xfer_busy_out;
+    sc_signal <bool> m_xfer_done_out;
+#endif
 
 public:
     Vsdram_axi *m_rtl;
 #if VM_TRACE
-    VerilatedVcdSc * m_vcd;
-    bool             m_delay_waves;
-    sc_core::sc_time m_waves_start;
+    sc_trace_file *  m_vcd;
 #endif 
 };
 
@@ -0,0 +1,172 @@
+#include "sdram_axi_model.h"
+
+// Cycles between core accepting a read and ack_q (rd_q + capture flops)
+#define READ_ACK_CYCLES(lat)    ((lat) + 3)
+// Cycles between core accepting a write and ack_q
+#define WRITE_ACK_CYCLES        2
+
+//-----------------------------------------------------------------
+// configure: Derive cycle timings as sdram_axi_core does
+//-----------------------------------------------------------------
+void sdram_axi_model::configure(int sdram_mhz, int addr_w, int col_w, int read_latency, int trcd_ns, int trp_ns, int trfc_ns,
+                                int bank_w, int rank_w)
+{
+    int cycle_ns     = 1000 / sdram_mhz;
+
+    m_col_w          = col_w;
+    m_row_w          = addr_w - col_w - bank_w;
+    m_slot_w         = bank_w + rank_w;
+    m_banks          = 1 << m_slot_w;
+    if (m_banks > MAX_BANKS)
+        m_banks = MAX_BANKS;
+    m_read_latency   = read_latency;
+
+    m_trcd           = (trcd_ns + (cycle_ns-1)) / cycle_ns;
+    m_trp            = (trp_ns  + (cycle_ns-1)) / cycle_ns;
+    m_trfc           = (trfc_ns + (cycle_ns-1)) / cycle_ns;
+
+    // refresh_timer_q: reloaded with SDRAM_REFRESH_CYCLES, fires on zero
+    m_refresh_period = ((64000 * (uint64_t)sdram_mhz) / (1 << m_row_w) - 1) + 1;
+#ifdef SDRAM_FAST_INIT
+    m_first_refresh  = 100 + 1;
+#else
+    m_first_refresh  = (100000 / cycle_ns) + 100 + 1;
+#endif
+
+    reset();
+}
+//-----------------------------------------------------------------
+// reset: Initial state (rows closed, init refreshes pending)
+//-----------------------------------------------------------------
+void sdram_axi_model::reset(void)
+{
+    for (int b=0;b<m_banks;b++)
+    {
+        m_row_open[b]   = false;
+        m_active_row[b] = 0;
+    }
+
+    // Controller leaves INIT on the first refresh timer expiry
+    m_next_refresh  = m_first_refresh;
+    m_idle          = m_first_refresh;
+    m_last_accept   = 0;
+    m_last_write    = false;
+    m_last_valid    = false;
+
+    m_row_hits      = 0;
+    m_row_misses    = 0;
+    m_row_conflicts = 0;
+    m_refreshes     = 0;
+}
+//-----------------------------------------------------------------
+// any_open: Any bank with an open row
+//-----------------------------------------------------------------
+bool sdram_axi_model::any_open(void)
+{
+    for (int b=0;b<m_banks;b++)
+        if (m_row_open[b])
+            return true;
+    return false;
+}
+//-----------------------------------------------------------------
+// refresh: Perform any refreshes due before cycle 'until'
+//-----------------------------------------------------------------
+void sdram_axi_model::refresh(uint64_t until)
+{
+    while (m_next_refresh <= until)
+    {
+        uint64_t start = (m_idle > m_next_refresh) ? m_idle : m_next_refresh;
+
+        // IDLE -> [PRECHARGE + tRP] -> REFRESH + tRFC -> IDLE
+        uint64_t cost  = 1 + (any_open() ? (1 + m_trp) : 0) + 1 + m_trfc;
+
+        for (int b=0;b<m_banks;b++)
+            m_row_open[b] = false;
+
+        m_idle          = start + cost;
+        m_next_refresh += m_refresh_period;
+        m_last_valid    = false;
+        m_refreshes    += 1;
+
+        if (until < m_idle)
+            until = m_idle;
+    }
+}
+//-----------------------------------------------------------------
+// access: Schedule one 32-bit beat, return ack cycle
+//-----------------------------------------------------------------
+uint64_t sdram_axi_model::access(uint64_t req, uint32_t addr, bool write)
+{
+    uint32_t b       = bank(addr);
+    uint32_t r       = row(addr);
+    bool     hit     = m_row_open[b] && m_active_row[b] == r;
+    uint64_t accept;
+
+    // Back-to-back hit of the same type: READ_WAIT -> READ / WRITE1 -> WRITE0
+    if (m_last_valid && hit && write == m_last_write &&
+        req <= (m_last_accept + 1) && (m_last_accept + 1) < m_next_refresh)
+    {
+        accept = m_last_accept + 2;
+        m_row_hits++;
+    }
+    else
+    {
+        uint64_t idle = (req > m_idle) ? req : m_idle;
+
+        // Refresh has priority in IDLE
+        refresh(idle);
+        if (m_idle > idle)
+            idle = m_idle;
+
+        hit = m_row_open[b] && m_active_row[b] == r;
+
+        // IDLE -> READ/WRITE0
+        if (hit)
+        {
+            accept = idle + 1;
+            m_row_hits++;
+        }
+        // IDLE -> ACTIVATE + tRCD -> READ/WRITE0
+        else if (!m_row_open[b])
+        {
+            accept = idle + 2 + m_trcd;
+            m_row_misses++;
+        }
+        // IDLE -> PRECHARGE + tRP -> ACTIVATE + tRCD -> READ/WRITE0
+        else
+        {
+            accept = idle + 3 + m_trp + m_trcd;
+            m_row_conflicts++;
+        }
+
+        m_row_open[b]   = true;
+        m_active_row[b] = r;
+    }
+
+    m_last_accept = accept;
+    m_last_write  = write;
+    m_last_valid  = true;
+
+    // Core returns to IDLE after WRITE1, or READ_WAIT + read latency delay
+    m_idle = accept + 2 + (write ? 0 : m_read_latency);
+
+    return accept + (write ? WRITE_ACK_CYCLES : READ_ACK_CYCLES(m_read_latency));
+}
+//-----------------------------------------------------------------
+// access_burst: Schedule an INCR burst, return last ack cycle
+//-----------------------------------------------------------------
+uint64_t sdram_axi_model::access_burst(uint64_t req, uint32_t addr, bool write, int beats)
+{
+    uint64_t done = req;
+
+    for (int i=0;i<beats;i++)
+    {
+        done = access(req, addr, write);
+
+        // Next beat presented as soon as this one is accepted
+        req   = m_last_accept;
+        addr += 4;
+    }
+
+    return done;
+}
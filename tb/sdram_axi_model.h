@@ -0,0 +1,80 @@
+#ifndef SDRAM_AXI_MODEL_H
+#define SDRAM_AXI_MODEL_H
+
+#include <stdint.h>
+
+//-------------------------------------------------------------
+// sdram_axi_model: Analytical timing model of sdram_axi
+//
+// Mirrors the RTL parameters, RBC address mapping, open row
+// policy and periodic refresh of sdram_axi_core. Each 32-bit
+// beat is scheduled against the bank state and the cycle at
+// which it completes (core ack) is returned. No SystemC.
+//-------------------------------------------------------------
+class sdram_axi_model
+{
+public:
+    sdram_axi_model(int sdram_mhz = 50, int addr_w = 24, int col_w = 9, int read_latency = 2)
+    {
+        configure(sdram_mhz, addr_w, col_w, read_latency);
+    }
+
+    // Timings (ns) as the RTL SDRAM_TRCD_NS / SDRAM_TRP_NS / SDRAM_TRFC_NS,
+    // geometry as SDRAM_BANK_W / SDRAM_RANK_W
+    void configure(int sdram_mhz, int addr_w, int col_w, int read_latency, int trcd_ns = 20, int trp_ns = 20, int trfc_ns = 60,
+                   int bank_w = 2, int rank_w = 0);
+    void reset(void);
+
+    // Schedule a single beat requested at cycle 'req', returns ack cycle
+    uint64_t access(uint64_t req, uint32_t addr, bool write);
+
+    // Schedule a burst of 32-bit beats (INCR), returns last ack cycle
+    uint64_t access_burst(uint64_t req, uint32_t addr, bool write, int beats);
+
+    // Address mapping (same as RTL, bank = {rank, bank})
+    uint32_t bank(uint32_t addr) { return (addr >> (m_col_w + 1)) & (m_banks - 1); }
+    uint32_t row(uint32_t addr)  { return (addr >> (m_col_w + m_slot_w + 1)) & ((1 << m_row_w) - 1); }
+
+    // Statistics
+    uint64_t row_hits(void)      { return m_row_hits; }
+    uint64_t row_misses(void)    { return m_row_misses; }
+    uint64_t row_conflicts(void) { return m_row_conflicts; }
+    uint64_t refreshes(void)     { return m_refreshes; }
+
+protected:
+    void     refresh(uint64_t until);
+    bool     any_open(void);
+
+protected:
+    static const int MAX_BANKS = 16;
+
+    // RTL derived timings (cycles)
+    int      m_col_w;
+    int      m_row_w;
+    int      m_slot_w;
+    int      m_banks;
+    int      m_read_latency;
+    int      m_trcd;
+    int      m_trp;
+    int      m_trfc;
+    uint64_t m_refresh_period;
+    uint64_t m_first_refresh;
+
+    // Bank state
+    bool     m_row_open[MAX_BANKS];
+    uint32_t m_active_row[MAX_BANKS];
+
+    // Core state
+    uint64_t m_next_refresh;
+    uint64_t m_idle;            // Cycle core returns to IDLE
+    uint64_t m_last_accept;     // Cycle last beat was accepted
+    bool     m_last_write;
+    bool     m_last_valid;
+
+    uint64_t m_row_hits;
+    uint64_t m_row_misses;
+    uint64_t m_row_conflicts;
+    uint64_t m_refreshes;
+};
+
+#endif
@@ -0,0 +1,81 @@
+#include "sdram_axi_tlm.h"
+
+// AR/AW handshake + request FIFO before the core sees the request
+#define AXI_REQ_CYCLES      1
+// R/B handshake after the core ack (response FIFO bypassed when empty)
+#define AXI_RESP_CYCLES     1
+
+//-----------------------------------------------------------------
+// Constructor
+//-----------------------------------------------------------------
+sdram_axi_tlm::sdram_axi_tlm(sc_module_name name, int sdram_mhz, int addr_w,
+                             int col_w, int read_latency): sc_module(name)
+                                                         , tsock("tsock")
+                                                         , m_model(sdram_mhz, addr_w, col_w, read_latency)
+{
+    tsock.register_b_transport(this, &sdram_axi_tlm::b_transport);
+
+    m_period          = sc_time(1000.0 / sdram_mhz, SC_NS);
+    m_origin          = SC_ZERO_TIME;
+    m_axi_req_cycles  = AXI_REQ_CYCLES;
+    m_axi_resp_cycles = AXI_RESP_CYCLES;
+}
+//-----------------------------------------------------------------
+// to_cycles: Convert absolute time to controller cycle number
+//-----------------------------------------------------------------
+uint64_t sdram_axi_tlm::to_cycles(sc_time t)
+{
+    if (t <= m_origin)
+        return 0;
+
+    return (uint64_t)(((t - m_origin) / m_period) + 0.5);
+}
+//-----------------------------------------------------------------
+// b_transport: Blocking transport (LT)
+//-----------------------------------------------------------------
+void sdram_axi_tlm::b_transport(tlm::tlm_generic_payload &trans, sc_time &delay)
+{
+    uint32_t addr   = (uint32_t)trans.get_address();
+    uint8_t *data   = trans.get_data_ptr();
+    int      length = trans.get_data_length();
+    bool     write  = trans.is_write();
+
+    if (!write && !trans.is_read())
+    {
+        trans.set_response_status(tlm::TLM_COMMAND_ERROR_RESPONSE);
+        return;
+    }
+
+    if (trans.get_byte_enable_ptr() || trans.get_streaming_width() < (unsigned)length)
+    {
+        trans.set_response_status(tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE);
+        return;
+    }
+
+    if (length <= 0 || !valid_addr(addr) || !valid_addr(addr + length - 1))
+    {
+        trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+        return;
+    }
+
+    // Data
+    for (int i=0;i<length;i++)
+    {
+        if (write)
+            this->write(addr + i, data[i]);
+        else
+            data[i] = this->read(addr + i);
+    }
+
+    // Timing: 32-bit beats covering the transfer
+    uint32_t first = addr & ~3;
+    int      beats = (((addr + length + 3) & ~3) - first) / 4;
+    uint64_t req   = to_cycles(sc_time_stamp() + delay) + m_axi_req_cycles;
+    uint64_t done  = m_model.access_burst(req, first, write, beats) + m_axi_resp_cycles;
+
+    sc_time  t_end = m_origin + (m_period * (double)done);
+    if (t_end > sc_time_stamp() + delay)
+        delay = t_end - sc_time_stamp();
+
+    trans.set_response_status(tlm::TLM_OK_RESPONSE);
+}
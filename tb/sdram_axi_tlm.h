@@ -0,0 +1,56 @@
+#ifndef SDRAM_AXI_TLM_H
+#define SDRAM_AXI_TLM_H
+
+#include <systemc.h>
+#include <tlm.h>
+#include <tlm_utils/simple_target_socket.h>
+#include "tb_memory.h"
+#include "sdram_axi_model.h"
+
+//-------------------------------------------------------------
+// sdram_axi_tlm: Loosely-timed TLM-2.0 model of sdram_axi
+//
+// b_transport only. Data is held in a tb_memory, latency comes
+// from sdram_axi_model plus a fixed AXI / pmem overhead.
+//-------------------------------------------------------------
+class sdram_axi_tlm: public sc_module, public tb_memory
+{
+public:
+    //-------------------------------------------------------------
+    // Interface I/O
+    //-------------------------------------------------------------
+    tlm_utils::simple_target_socket<sdram_axi_tlm> tsock;
+
+    //-------------------------------------------------------------
+    // Constructor
+    //-------------------------------------------------------------
+    sdram_axi_tlm(sc_module_name name, int sdram_mhz = 50, int addr_w = 24,
+                  int col_w = 9, int read_latency = 2);
+
+    // Controller clock period / time of reset release (cycle 0)
+    void            set_period(sc_time period) { m_period = period; }
+    void            set_origin(sc_time origin) { m_origin = origin; }
+
+    // Cycles added before the core sees a request / after its ack
+    void            set_axi_overhead(int req_cycles, int resp_cycles)
+    {
+        m_axi_req_cycles  = req_cycles;
+        m_axi_resp_cycles = resp_cycles;
+    }
+
+    sdram_axi_model &model(void) { return m_model; }
+
+    // Internal
+protected:
+    void            b_transport(tlm::tlm_generic_payload &trans, sc_time &delay);
+    uint64_t        to_cycles(sc_time t);
+
+protected:
+    sdram_axi_model m_model;
+    sc_time         m_period;
+    sc_time         m_origin;
+    int             m_axi_req_cycles;
+    int             m_axi_resp_cycles;
+};
+
+#endif
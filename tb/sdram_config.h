@@ -0,0 +1,50 @@
+#ifndef SDRAM_CONFIG_H
+#define SDRAM_CONFIG_H
+
+//-----------------------------------------------------------------
+// Build defaults: RTL parameters the testbenches need to know,
+// overridden by -D (make regression, make PROFILE=...). Must match
+// the sdram_axi / sdram_axi_core parameter defaults.
+//-----------------------------------------------------------------
+#ifndef SDRAM_MHZ
+    #define SDRAM_MHZ           50
+#endif
+#ifndef SDRAM_ADDR_W
+    #define SDRAM_ADDR_W        24
+#endif
+#ifndef SDRAM_COL_W
+    #define SDRAM_COL_W         9
+#endif
+#ifndef SDRAM_BANK_W
+    #define SDRAM_BANK_W        2
+#endif
+#ifndef SDRAM_RANK_W
+    #define SDRAM_RANK_W        0
+#endif
+#ifndef SDRAM_ROW_W
+    #define SDRAM_ROW_W         (SDRAM_ADDR_W - SDRAM_COL_W - SDRAM_BANK_W)
+#endif
+#ifndef SDRAM_READ_LATENCY
+    #define SDRAM_READ_LATENCY  2
+#endif
+#ifndef SDRAM_READ_CAL
+    #define SDRAM_READ_CAL      0
+#endif
+#ifndef SDRAM_TRCD_NS
+    #define SDRAM_TRCD_NS       20
+#endif
+#ifndef SDRAM_TRP_NS
+    #define SDRAM_TRP_NS        20
+#endif
+#ifndef SDRAM_TRFC_NS
+    #define SDRAM_TRFC_NS       60
+#endif
+
+#define SDRAM_RANKS             (1 << SDRAM_RANK_W)
+
+// Timing rules checked by the SDRAM model (sdram_timing_checker.cpp)
+#ifndef SDRAM_SPEED_GRADE
+    #define SDRAM_SPEED_GRADE   "MT48LC16M16A2-75"
+#endif
+
+#endif
@@ -2,6 +2,7 @@
 #define SDRAM_IO_H
 
 #include <systemc.h>
+#include "sdram_config.h"
 
 //----------------------------------------------------------------
 // Interface (master)
@@ -9,18 +10,18 @@
 class sdram_io_master
 {
 public:
-    // Members
-    sc_uint <1> CLK;
-    sc_uint <1> CKE;
-    sc_uint <1> CS;
-    sc_uint <1> RAS;
-    sc_uint <1> CAS;
-    sc_uint <1> WE;
-    sc_uint <2> DQM;
-    sc_uint <13> ADDR;
-    sc_uint <2> BA;
-    sc_uint <16> DATA_OUTPUT;
-    sc_uint <1> DATA_OUT_EN;
+    // Members (native integers: cheap copy / compare per signal update)
+    bool     CLK;
+    bool     CKE;
+    uint8_t  CS;         // Active low, one per rank
+    bool     RAS;
+    bool     CAS;
+    bool     WE;
+    uint8_t  DQM;
+    uint16_t ADDR;
+    uint8_t  BA;
+    uint16_t DATA_OUTPUT;
+    bool     DATA_OUT_EN;
 
     // Construction
     sdram_io_master() { init(); }
@@ -61,30 +62,30 @@ public:
     {
         sc_trace(tf,v.CLK, path + "/clk");
         sc_trace(tf,v.CKE, path + "/cke");
-        sc_trace(tf,v.CS, path + "/cs");
+        sc_trace(tf,v.CS, path + "/cs", SDRAM_RANKS);
         sc_trace(tf,v.RAS, path + "/ras");
         sc_trace(tf,v.CAS, path + "/cas");
         sc_trace(tf,v.WE, path + "/we");
-        sc_trace(tf,v.DQM, path + "/dqm");
-        sc_trace(tf,v.ADDR, path + "/addr");
-        sc_trace(tf,v.BA, path + "/ba");
-        sc_trace(tf,v.DATA_OUTPUT, path + "/data_output");
+        sc_trace(tf,v.DQM, path + "/dqm", 2);
+        sc_trace(tf,v.ADDR, path + "/addr", 13);
+        sc_trace(tf,v.BA, path + "/ba", SDRAM_BANK_W);
+        sc_trace(tf,v.DATA_OUTPUT, path + "/data_output", 16);
         sc_trace(tf,v.DATA_OUT_EN, path + "/data_out_en");
     }
 
     friend ostream& operator << (ostream& os, sdram_io_master const & v)
     {
-        os << hex << "CLK: " << v.CLK << " ";
-        os << hex << "CKE: " << v.CKE << " ";
-        os << hex << "CS: " << v.CS << " ";
-        os << hex << "RAS: " << v.RAS << " ";
-        os << hex << "CAS: " << v.CAS << " ";
-        os << hex << "WE: " << v.WE << " ";
-        os << hex << "DQM: " << v.DQM << " ";
-        os << hex << "ADDR: " << v.ADDR << " ";
-        os << hex << "BA: " << v.BA << " ";
-        os << hex << "DATA_OUTPUT: " << v.DATA_OUTPUT << " ";
-        os << hex << "DATA_OUT_EN: " << v.DATA_OUT_EN << " ";
+        os << hex << "CLK: " << (unsigned)v.CLK << " ";
+        os << hex << "CKE: " << (unsigned)v.CKE << " ";
+        os << hex << "CS: " << (unsigned)v.CS << " ";
+        os << hex << "RAS: " << (unsigned)v.RAS << " ";
+        os << hex << "CAS: " << (unsigned)v.CAS << " ";
+        os << hex << "WE: " << (unsigned)v.WE << " ";
+        os << hex << "DQM: " << (unsigned)v.DQM << " ";
+        os << hex << "ADDR: " << (unsigned)v.ADDR << " ";
+        os << hex << "BA: " << (unsigned)v.BA << " ";
+        os << hex << "DATA_OUTPUT: " << (unsigned)v.DATA_OUTPUT << " ";
+        os << hex << "DATA_OUT_EN: " << (unsigned)v.DATA_OUT_EN << " ";
         return os;
     }
 
@@ -115,8 +116,8 @@ public:
 class sdram_io_slave
 {
 public:
-    // Members
-    sc_uint <16> DATA_INPUT;
+    // Members (native integers: cheap copy / compare per signal update)
+    uint16_t DATA_INPUT;
 
     // Construction
     sdram_io_slave() { init(); }
@@ -135,12 +136,12 @@ public:
 
     friend void sc_trace(sc_trace_file *tf, const sdram_io_slave & v, const std::string & path)
     {
-        sc_trace(tf,v.DATA_INPUT, path + "/data_input");
+        sc_trace(tf,v.DATA_INPUT, path + "/data_input", 16);
     }
 
     friend ostream& operator << (ostream& os, sdram_io_slave const & v)
     {
-        os << hex << "DATA_INPUT: " << v.DATA_INPUT << " ";
+        os << hex << "DATA_INPUT: " << (unsigned)v.DATA_INPUT << " ";
         return os;
     }
 
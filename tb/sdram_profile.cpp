@@ -0,0 +1,73 @@
+#include "sdram_profile.h"
+#include <stdio.h>
+#include <string.h>
+
+//-----------------------------------------------------------------
+// Profiles
+//-----------------------------------------------------------------
+const sdram_profile sdram_profiles[] =
+{
+    //  name                row_w col_w bank_w data_w grade
+    { "MT48LC16M16A2-75",   13,   9,    2,     16,    "MT48LC16M16A2-75" },
+    { "MT48LC16M16A2-7E",   13,   9,    2,     16,    "MT48LC16M16A2-7E" },
+    { "MT48LC16M16A2-6A",   13,   9,    2,     16,    "MT48LC16M16A2-6A" },
+    { "AS4C16M16S-6",       13,   9,    2,     16,    "AS4C16M16S-6"     },
+    { "IS42S16320D-7",      13,   10,   2,     16,    "IS42S16320D-7"    },
+    { "IS42S32800J-6",      12,   9,    2,     32,    "IS42S32800J-6"    },
+    { "MT48LC4M32B2-6",     12,   8,    2,     32,    "MT48LC4M32B2-6"   },
+    { NULL }
+};
+
+//-----------------------------------------------------------------
+// sdram_profile_find: Lookup by name (NULL = not found)
+//-----------------------------------------------------------------
+const sdram_profile *sdram_profile_find(const char *name)
+{
+    for (int i=0;sdram_profiles[i].name;i++)
+        if (!strcmp(sdram_profiles[i].name, name))
+            return &sdram_profiles[i];
+
+    return NULL;
+}
+//-----------------------------------------------------------------
+// sdram_profile_grade: Timing for a profile
+//-----------------------------------------------------------------
+const sdram_speed_grade *sdram_profile_grade(const sdram_profile *p)
+{
+    return sdram_speed_grade_find(p->grade);
+}
+//-----------------------------------------------------------------
+// sdram_profile_supported: Fits the controller's fixed widths
+//-----------------------------------------------------------------
+bool sdram_profile_supported(const sdram_profile *p, bool verbose)
+{
+    const char *reason = NULL;
+
+    if (p->data_w != 16)
+        reason = "data bus is not x16";
+    else if (p->bank_w != 2 && p->bank_w != 3)
+        reason = "not 4 or 8 banks";
+    else if (p->row_w > 13 || p->col_w > 10)
+        reason = "more than 13 address lines (or A10 used for columns)";
+    else if (!sdram_profile_grade(p))
+        reason = "no speed grade";
+
+    if (reason && verbose)
+        printf("ERROR: SDRAM profile %s not supported by sdram_axi: %s\n", p->name, reason);
+
+    return reason == NULL;
+}
+//-----------------------------------------------------------------
+// sdram_profile_list: Print the table
+//-----------------------------------------------------------------
+void sdram_profile_list(void)
+{
+    for (int i=0;sdram_profiles[i].name;i++)
+    {
+        const sdram_profile *p = &sdram_profiles[i];
+
+        printf("PROFILE: name=%s rows=%d cols=%d banks=%d data_w=%d supported=%d\n",
+                p->name, 1 << p->row_w, 1 << p->col_w, 1 << p->bank_w, p->data_w,
+                sdram_profile_supported(p, false));
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef SDRAM_PROFILE_H
+#define SDRAM_PROFILE_H
+
+#include "sdram_timing_checker.h"
+
+//-------------------------------------------------------------
+// sdram_profile: SDRAM part geometry + speed grade
+//-------------------------------------------------------------
+typedef struct sdram_profile_s
+{
+    const char *name;
+    int         row_w;
+    int         col_w;
+    int         bank_w;
+    int         data_w;
+    const char *grade;      // sdram_speed_grades[] entry
+} sdram_profile;
+
+// Table terminated by a NULL name
+extern const sdram_profile sdram_profiles[];
+const sdram_profile *     sdram_profile_find(const char *name);
+const sdram_speed_grade * sdram_profile_grade(const sdram_profile *p);
+
+// Total word address width (SDRAM_ADDR_W)
+static inline int sdram_profile_addr_w(const sdram_profile *p) { return p->row_w + p->col_w + p->bank_w; }
+
+// Can sdram_axi (x16, 4 or 8 banks, 13 address lines) drive this part?
+bool sdram_profile_supported(const sdram_profile *p, bool verbose = true);
+
+void sdram_profile_list(void);
+
+#endif
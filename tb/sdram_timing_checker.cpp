@@ -0,0 +1,252 @@
+#include "sdram_timing_checker.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// Allowance on the refresh interval (controller waits for the current access)
+#define REFI_SLACK_NS     200
+
+#define NEVER             (-(1LL << 40))
+
+//-----------------------------------------------------------------
+// Speed grades
+//-----------------------------------------------------------------
+// REF: https://www.micron.com/~/media/documents/products/data-sheet/dram/128mb_x4x8x16_ait-aat_sdram.pdf
+//      Alliance AS4C16M16S, ISSI IS42S16320D / IS42S32800J, Micron MT48LC4M32B2 data sheets
+const sdram_speed_grade sdram_speed_grades[] =
+{
+    //  name                tRCD  tRP   tRAS  tRAS_max  tRC   tRRD  tWR   tRFC  tREF      tMRD
+    { "MT48LC16M16A2-75",   20,   20,   44,   120000,   66,   15,   15,   66,   64000000, 2 },
+    { "MT48LC16M16A2-7E",   15,   15,   37,   120000,   60,   14,   14,   66,   64000000, 2 },
+    { "MT48LC16M16A2-6A",   18,   18,   42,   120000,   60,   12,   12,   60,   64000000, 2 },
+    { "AS4C16M16S-6",       18,   18,   42,   100000,   60,   12,   12,   60,   64000000, 2 },
+    { "IS42S16320D-7",      15,   15,   37,   100000,   60,   14,   14,   60,   64000000, 2 },
+    { "IS42S32800J-6",      18,   18,   42,   100000,   60,   12,   12,   60,   64000000, 2 },
+    { "MT48LC4M32B2-6",     18,   18,   42,   120000,   60,   12,   12,   60,   64000000, 2 },
+    { NULL }
+};
+
+//-----------------------------------------------------------------
+// sdram_speed_grade_find: Lookup by name (NULL = not found)
+//-----------------------------------------------------------------
+const sdram_speed_grade *sdram_speed_grade_find(const char *name)
+{
+    for (int i=0;sdram_speed_grades[i].name;i++)
+        if (!strcmp(sdram_speed_grades[i].name, name))
+            return &sdram_speed_grades[i];
+
+    return NULL;
+}
+
+//-----------------------------------------------------------------
+// Rules: checked on each command against the stamped events
+//-----------------------------------------------------------------
+const sdram_timing_checker::t_rule sdram_timing_checker::m_rules[] =
+{
+    // cmd          from           scope        param
+    { CMD_ACTIVE,    EV_PRECHARGE,  BANK_SAME,   T_RP      },
+    { CMD_ACTIVE,    EV_ACTIVE,     BANK_SAME,   T_RC      },
+    { CMD_ACTIVE,    EV_ACTIVE,     BANK_OTHER,  T_RRD     },
+    { CMD_ACTIVE,    EV_REFRESH,    BANK_SAME,   T_RFC     },
+    { CMD_ACTIVE,    EV_LOAD_MODE,  BANK_SAME,   T_MRD     },
+    { CMD_READ,      EV_ACTIVE,     BANK_SAME,   T_RCD     },
+    { CMD_WRITE,     EV_ACTIVE,     BANK_SAME,   T_RCD     },
+    { CMD_PRECHARGE, EV_ACTIVE,     BANK_SAME,   T_RAS     },
+    { CMD_PRECHARGE, EV_ACTIVE,     BANK_SAME,   T_RAS_MAX },
+    { CMD_PRECHARGE, EV_WRITE_DATA, BANK_SAME,   T_WR      },
+    { CMD_REFRESH,   EV_PRECHARGE,  BANK_SAME,   T_RP      },
+    { CMD_REFRESH,   EV_REFRESH,    BANK_SAME,   T_RFC     },
+    { CMD_REFRESH,   EV_REFRESH,    BANK_SAME,   T_REFI    },
+    { CMD_REFRESH,   EV_LOAD_MODE,  BANK_SAME,   T_MRD     },
+    { CMD_LOAD_MODE, EV_PRECHARGE,  BANK_SAME,   T_RP      },
+    { CMD_LOAD_MODE, EV_REFRESH,    BANK_SAME,   T_RFC     },
+    { CMD_MAX }
+};
+
+const char * sdram_timing_checker::m_param_names[T_MAX] =
+{
+    "tRCD", "tRP", "tRAS", "tRAS(max)", "tRC", "tRRD", "tWR", "tRFC", "tREFI", "tMRD"
+};
+
+//-----------------------------------------------------------------
+// configure: Convert the speed grade to cycles at this clock
+//-----------------------------------------------------------------
+void sdram_timing_checker::configure(const sdram_speed_grade *grade, int sdram_mhz, int row_w, uint32_t banks)
+{
+    double cycle_ns = 1000.0 / sdram_mhz;
+
+    m_grade = grade;
+    m_banks = banks > MAX_BANKS ? MAX_BANKS : banks;
+
+    // Minimums round up, maximums round down
+    m_cycles[T_RCD]     = (uint32_t)ceil(grade->tRCD / cycle_ns);
+    m_cycles[T_RP]      = (uint32_t)ceil(grade->tRP  / cycle_ns);
+    m_cycles[T_RAS]     = (uint32_t)ceil(grade->tRAS / cycle_ns);
+    m_cycles[T_RAS_MAX] = (uint32_t)floor(grade->tRAS_max / cycle_ns);
+    m_cycles[T_RC]      = (uint32_t)ceil(grade->tRC  / cycle_ns);
+    m_cycles[T_RRD]     = (uint32_t)ceil(grade->tRRD / cycle_ns);
+    m_cycles[T_WR]      = (uint32_t)ceil(grade->tWR  / cycle_ns);
+    m_cycles[T_RFC]     = (uint32_t)ceil(grade->tRFC / cycle_ns);
+    m_cycles[T_REFI]    = (uint32_t)floor((grade->tREF / (1 << row_w) + REFI_SLACK_NS) / cycle_ns);
+    m_cycles[T_MRD]     = grade->tMRD;
+
+    reset();
+}
+//-----------------------------------------------------------------
+// reset: Power-up state (all banks idle, no history)
+//-----------------------------------------------------------------
+void sdram_timing_checker::reset(void)
+{
+    m_cycle              = 0;
+    m_burst_length       = 1;
+    m_write_burst_length = 1;
+    m_refreshes          = 0;
+    m_violations         = 0;
+
+    for (int e=0;e<EV_MAX;e++)
+        for (uint32_t b=0;b<MAX_BANKS;b++)
+            m_last[e][b] = NEVER;
+
+    for (uint32_t b=0;b<MAX_BANKS;b++)
+        m_open[b] = false;
+}
+//-----------------------------------------------------------------
+// decode: Command from CS/RAS/CAS/WE
+//-----------------------------------------------------------------
+sdram_timing_checker::t_cmd sdram_timing_checker::decode(bool cs, bool ras, bool cas, bool we)
+{
+    static const t_cmd cmds[8] =
+    {
+        CMD_LOAD_MODE, CMD_REFRESH, CMD_PRECHARGE, CMD_ACTIVE,
+        CMD_WRITE,     CMD_READ,    CMD_BURST_TERM, CMD_NOP
+    };
+
+    return cs ? CMD_NOP : cmds[(ras << 2) | (cas << 1) | we];
+}
+//-----------------------------------------------------------------
+// violation: Report a broken rule
+//-----------------------------------------------------------------
+void sdram_timing_checker::violation(t_param p, uint32_t bank, int64_t elapsed, uint32_t limit)
+{
+    printf("ERROR: SDRAM %s violated (bank %u): %lld cycles, %s %u @ cycle %lld\n",
+            m_param_names[p], bank, (long long)elapsed,
+            (p == T_RAS_MAX || p == T_REFI) ? "max" : "min", limit, (long long)m_cycle);
+    m_violations++;
+}
+//-----------------------------------------------------------------
+// check: One clock
+//-----------------------------------------------------------------
+bool sdram_timing_checker::check(t_cmd cmd, uint32_t bank, uint32_t addr)
+{
+    uint64_t errors = m_violations;
+    bool     a10    = (addr >> 10) & 1;
+
+    m_cycle++;
+
+    if (cmd == CMD_NOP || cmd == CMD_BURST_TERM)
+        return true;
+
+    // Banks the command applies to (precharging an idle bank is a NOP)
+    uint32_t targets = 0;
+    if (cmd == CMD_REFRESH || cmd == CMD_LOAD_MODE || (cmd == CMD_PRECHARGE && a10))
+        targets = (1 << m_banks) - 1;
+    else
+        targets = 1 << bank;
+
+    if (cmd == CMD_PRECHARGE)
+        for (uint32_t b=0;b<m_banks;b++)
+            if (!m_open[b])
+                targets &= ~(1 << b);
+
+    for (int r=0;m_rules[r].cmd != CMD_MAX;r++)
+    {
+        const t_rule &rule = m_rules[r];
+        if (rule.cmd != cmd)
+            continue;
+
+        // Initialisation refreshes are back-to-back
+        if (rule.param == T_REFI && m_refreshes <= 2)
+            continue;
+
+        bool     max   = (rule.param == T_RAS_MAX || rule.param == T_REFI);
+        uint32_t limit = m_cycles[rule.param];
+
+        for (uint32_t b=0;b<m_banks;b++)
+        {
+            bool in_scope = (targets >> b) & 1;
+            if (rule.scope == BANK_OTHER)
+                in_scope = !in_scope;
+
+            if (!in_scope || m_last[rule.from][b] == NEVER)
+                continue;
+
+            int64_t elapsed = m_cycle - m_last[rule.from][b];
+
+            // One report per rule
+            if (max ? (elapsed > limit) : (elapsed < limit))
+            {
+                violation(rule.param, b, elapsed, limit);
+                break;
+            }
+        }
+    }
+
+    // Stamp events
+    switch (cmd)
+    {
+        case CMD_ACTIVE:
+            m_last[EV_ACTIVE][bank] = m_cycle;
+            m_open[bank]            = true;
+            break;
+        case CMD_READ:
+        case CMD_WRITE:
+        {
+            int64_t last_data = m_cycle + ((cmd == CMD_WRITE) ? m_write_burst_length : m_burst_length) - 1;
+
+            if (cmd == CMD_WRITE)
+                m_last[EV_WRITE_DATA][bank] = last_data;
+
+            // Auto precharge starts after the burst (and tWR for writes)
+            if (a10)
+            {
+                m_last[EV_PRECHARGE][bank] = (cmd == CMD_WRITE) ? (last_data + m_cycles[T_WR]) : (last_data + 1);
+                m_open[bank]               = false;
+            }
+        }
+        break;
+        case CMD_PRECHARGE:
+            for (uint32_t b=0;b<m_banks;b++)
+                if ((targets >> b) & 1)
+                {
+                    m_last[EV_PRECHARGE][b] = m_cycle;
+                    m_open[b]               = false;
+                }
+            break;
+        case CMD_REFRESH:
+            for (uint32_t b=0;b<m_banks;b++)
+                m_last[EV_REFRESH][b] = m_cycle;
+            if (m_refreshes < 0xFFFFFFFF)
+                m_refreshes++;
+            break;
+        case CMD_LOAD_MODE:
+            for (uint32_t b=0;b<m_banks;b++)
+                m_last[EV_LOAD_MODE][b] = m_cycle;
+            m_burst_length       = 1 << (addr & 0x3);
+            m_write_burst_length = ((addr >> 9) & 1) ? 1 : m_burst_length;
+            break;
+        default:
+            break;
+    }
+
+    return errors == m_violations;
+}
+//-----------------------------------------------------------------
+// print_config: Rule limits in cycles
+//-----------------------------------------------------------------
+void sdram_timing_checker::print_config(void)
+{
+    printf("SDRAM: grade=%s", m_grade->name);
+    for (int p=0;p<T_MAX;p++)
+        printf(" %s=%u", m_param_names[p], m_cycles[p]);
+    printf("\n");
+}
@@ -0,0 +1,155 @@
+#ifndef SDRAM_TIMING_CHECKER_H
+#define SDRAM_TIMING_CHECKER_H
+
+#include <stdint.h>
+
+//-------------------------------------------------------------
+// sdram_speed_grade: SDR SDRAM AC timing (ns, tMRD in cycles)
+//-------------------------------------------------------------
+typedef struct sdram_speed_grade_s
+{
+    const char *name;
+    double      tRCD;     // ACTIVE -> READ / WRITE
+    double      tRP;      // PRECHARGE -> ACTIVE / REFRESH
+    double      tRAS;     // ACTIVE -> PRECHARGE (min)
+    double      tRAS_max; // ACTIVE -> PRECHARGE (max)
+    double      tRC;      // ACTIVE -> ACTIVE (same bank)
+    double      tRRD;     // ACTIVE -> ACTIVE (other bank)
+    double      tWR;      // Last write data -> PRECHARGE
+    double      tRFC;     // REFRESH -> ACTIVE / REFRESH
+    double      tREF;     // Refresh period for all rows
+    int         tMRD;     // LOAD MODE -> command
+} sdram_speed_grade;
+
+// Table terminated by a NULL name
+extern const sdram_speed_grade sdram_speed_grades[];
+const sdram_speed_grade *sdram_speed_grade_find(const char *name);
+
+//-------------------------------------------------------------
+// sdram_timing_checker: Table driven command timing checker
+//
+// Called once per SDRAM clock with the command on the pins.
+// Keeps per-bank cycle stamps of the last ACTIVE / PRECHARGE /
+// write data, checks every rule in the table that ends at the
+// new command and reports the ones violated. No SystemC.
+//-------------------------------------------------------------
+class sdram_timing_checker
+{
+public:
+    typedef enum
+    {
+        CMD_NOP = 0,
+        CMD_ACTIVE,
+        CMD_READ,
+        CMD_WRITE,
+        CMD_BURST_TERM,
+        CMD_PRECHARGE,
+        CMD_REFRESH,
+        CMD_LOAD_MODE,
+        CMD_MAX
+    } t_cmd;
+
+    typedef enum
+    {
+        T_RCD = 0,
+        T_RP,
+        T_RAS,
+        T_RAS_MAX,
+        T_RC,
+        T_RRD,
+        T_WR,
+        T_RFC,
+        T_REFI,
+        T_MRD,
+        T_MAX
+    } t_param;
+
+    static const uint32_t MAX_BANKS = 8;
+
+    sdram_timing_checker(const sdram_speed_grade *grade = sdram_speed_grades, int sdram_mhz = 50, int row_w = 13, uint32_t banks = 4)
+    {
+        configure(grade, sdram_mhz, row_w, banks);
+    }
+
+    void         configure(const sdram_speed_grade *grade, int sdram_mhz, int row_w, uint32_t banks = 4);
+    void         reset(void);
+
+    // Pins to command (CS high = NOP)
+    static t_cmd decode(bool cs, bool ras, bool cas, bool we);
+
+    // One clock: returns false if the command breaks a timing rule
+    bool         check(t_cmd cmd, uint32_t bank, uint32_t addr);
+
+    uint32_t     cycles(t_param p)  { return m_cycles[p]; }
+    uint64_t     violations(void)   { return m_violations; }
+    const char * grade(void)        { return m_grade->name; }
+    void         print_config(void);
+
+    // Checkpoint (T = VerilatedSerialize / VerilatedDeserialize)
+    template <class T> void save(T &os)
+    {
+        os.write(&m_cycle, sizeof(m_cycle));
+        os.write(m_last, sizeof(m_last));
+        os.write(m_open, sizeof(m_open));
+        os.write(&m_burst_length, sizeof(m_burst_length));
+        os.write(&m_write_burst_length, sizeof(m_write_burst_length));
+        os.write(&m_refreshes, sizeof(m_refreshes));
+        os.write(&m_violations, sizeof(m_violations));
+    }
+    template <class T> void restore(T &is)
+    {
+        is.read(&m_cycle, sizeof(m_cycle));
+        is.read(m_last, sizeof(m_last));
+        is.read(m_open, sizeof(m_open));
+        is.read(&m_burst_length, sizeof(m_burst_length));
+        is.read(&m_write_burst_length, sizeof(m_write_burst_length));
+        is.read(&m_refreshes, sizeof(m_refreshes));
+        is.read(&m_violations, sizeof(m_violations));
+    }
+
+protected:
+    // Events rules are measured from (per bank, REFRESH / LOAD MODE stamp all)
+    typedef enum
+    {
+        EV_ACTIVE = 0,
+        EV_PRECHARGE,
+        EV_WRITE_DATA,
+        EV_REFRESH,
+        EV_LOAD_MODE,
+        EV_MAX
+    } t_event;
+
+    typedef enum
+    {
+        BANK_SAME,      // Targeted bank(s)
+        BANK_OTHER      // Any bank other than the targeted one
+    } t_scope;
+
+    typedef struct
+    {
+        t_cmd    cmd;       // Rule ends at this command...
+        t_event  from;      // ...measured from this event
+        t_scope  scope;
+        t_param  param;
+    } t_rule;
+
+    static const t_rule   m_rules[];
+    static const char *   m_param_names[T_MAX];
+
+    void         violation(t_param p, uint32_t bank, int64_t elapsed, uint32_t limit);
+
+protected:
+    const sdram_speed_grade *m_grade;
+    uint32_t     m_banks;
+    uint32_t     m_cycles[T_MAX];
+
+    int64_t      m_cycle;
+    int64_t      m_last[EV_MAX][MAX_BANKS];
+    bool         m_open[MAX_BANKS];
+    int          m_burst_length;
+    int          m_write_burst_length;
+    uint32_t     m_refreshes;
+    uint64_t     m_violations;
+};
+
+#endif
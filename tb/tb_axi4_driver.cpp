@@ -3,14 +3,6 @@
 
 #define BURSTABLE(addr, length, burst_size)  (!(addr & (burst_size-1)) && length >= burst_size)
 
-typedef struct axi_resp_s
-{
-    uint32_t addr;
-    uint32_t size;
-    uint32_t id;
-    uint32_t last;
-} axi_resp_t;
-
 //-----------------------------------------------------------------
 // write_internal: Write a block to a target
 //-----------------------------------------------------------------
@@ -125,8 +117,19 @@ void tb_axi4_driver::write_internal(uint32_t addr, uint8_t *data, int length, ui
         }
     }
 
+    write_issue(req_q, resp_q);
+}
+//-----------------------------------------------------------------
+// write_issue: Issue write requests, wait for responses
+//-----------------------------------------------------------------
+void tb_axi4_driver::write_issue(std::queue <axi4_master> &req_q, std::queue <axi4_master> &resp_q)
+{
     bool split_addr_data = false;
 
+    // Data first: address held back for a later cycle
+    bool        addr_pending = false;
+    axi4_master addr_q;
+
     // Issue requests, wait for responses
     while (req_q.size() > 0 || resp_q.size() > 0)
     {
@@ -180,12 +183,21 @@ void tb_axi4_driver::write_internal(uint32_t addr, uint8_t *data, int length, ui
             }
         }
         // Issue new address, data cycle?
-        else if (!axi_o.AWVALID && !axi_o.WVALID && req_q.size() > 0 && !delay_cycle())
+        else if (!axi_o.AWVALID && !axi_o.WVALID && req_q.size() > 0 &&
+                 !(addr_pending && req_q.front().AWVALID) && !delay_cycle())
         {
             axi_o = req_q.front();
 
+            // Present data ahead of the address randomly
+            if (axi_o.AWVALID && m_wdata_first && delay_cycle())
+            {
+                addr_q       = axi_o;
+                addr_pending = true;
+                axi_o.AWVALID = false;
+                req_q.pop();
+            }
             // Delay first tick of data randomly
-            if (axi_o.AWVALID && delay_cycle())
+            else if (axi_o.AWVALID && delay_cycle())
             {
                 split_addr_data = true;
                 axi_o.WVALID = false;
@@ -197,6 +209,17 @@ void tb_axi4_driver::write_internal(uint32_t addr, uint8_t *data, int length, ui
                 req_q.pop();
         }
 
+        // Held back address
+        if (addr_pending && !axi_o.AWVALID && !delay_cycle())
+        {
+            axi_o.AWVALID = true;
+            axi_o.AWADDR  = addr_q.AWADDR;
+            axi_o.AWID    = addr_q.AWID;
+            axi_o.AWLEN   = addr_q.AWLEN;
+            axi_o.AWBURST = addr_q.AWBURST;
+            addr_pending  = false;
+        }
+
         axi_o.BREADY = !delay_cycle();
         axi_out.write(axi_o);
 
@@ -217,6 +240,7 @@ void tb_axi4_driver::read(uint32_t addr, uint8_t *data, int length)
 {
     std::queue <axi4_master> req_q;
     std::queue <axi_resp_t>  resp_q;    
+    uint32_t                 offset = 0;
 
     // Generate read requests
     while (length > 0)
@@ -259,10 +283,13 @@ void tb_axi4_driver::read(uint32_t addr, uint8_t *data, int length)
             resp.size = size;
             resp.id   = id;
             resp.last = true;
+            resp.offset = offset;
+            resp.seq  = req_q.size();
             resp_q.push(resp);
 
             addr += size;
             length -= size;
+            offset += size;
         }
         else
         {
@@ -285,16 +312,41 @@ void tb_axi4_driver::read(uint32_t addr, uint8_t *data, int length)
                 resp.size = 4;
                 resp.id   = id;
                 resp.last = (i + 1) == (chunk / 4);
+                resp.offset = offset;
+                resp.seq  = req_q.size();
                 resp_q.push(resp);
 
                 addr += 4;
                 length -= 4;
+                offset += 4;
             }
         }
     }
 
+    read_issue(req_q, resp_q, data);
+}
+//-----------------------------------------------------------------
+// read_issue: Issue read requests, wait for responses
+//-----------------------------------------------------------------
+// Responses are only required to be in order within an ID; different
+// IDs may complete out of order so expected beats are queued per ID.
+void tb_axi4_driver::read_issue(std::queue <axi4_master> &req_q, std::queue <axi_resp_t> &resp_q, uint8_t *data)
+{
+    std::queue <axi_resp_t> id_q[1 << AXI4_ID_W];
+    int                     remaining = resp_q.size();
+    bool                    first     = true;
+
+    while (resp_q.size() > 0)
+    {
+        axi_resp_t resp = resp_q.front();
+        resp_q.pop();
+
+        sc_assert(resp.id < (1 << AXI4_ID_W));
+        id_q[resp.id].push(resp);
+    }
+
     // Issue AXI transactions, wait for responses
-    while (req_q.size() > 0 || resp_q.size() > 0)
+    while (req_q.size() > 0 || remaining > 0)
     {
         axi4_master axi_o = axi_out.read();
         axi4_slave  axi_i = axi_in.read();
@@ -302,24 +354,40 @@ void tb_axi4_driver::read(uint32_t addr, uint8_t *data, int length)
         // Read response
         if (axi_i.RVALID && axi_o.RREADY)
         {
-            sc_assert(resp_q.size() > 0);
+            uint32_t id = (uint32_t)axi_i.RID;
 
-            axi_resp_t resp = resp_q.front();
-            resp_q.pop();
+            if (id_q[id].size() == 0)
+                printf("ERROR: Unexpected read response ID %d\n", id);
+            sc_assert(id_q[id].size() > 0);
+
+            axi_resp_t resp = id_q[id].front();
+            id_q[id].pop();
+            remaining--;
+
+            if (first)
+                m_first_resp = sc_time_stamp();
+            first = false;
 
-            sc_assert(axi_i.RID == resp.id);
             sc_assert(axi_i.RRESP == AXI4_RESP_OKAY);
             sc_assert(axi_i.RLAST == resp.last);
 
             uint32_t addr_offset = resp.addr & 3;
             uint32_t resp_data = (uint32_t)axi_i.RDATA;
             for (int x=0;x<resp.size;x++)
-               *data++ = resp_data >> (8 * (addr_offset + x));
+               data[resp.offset + x] = resp_data >> (8 * (addr_offset + x));
 
            if (axi_i.RLAST)
            {
                 sc_assert(m_resp_pending > 0);
                 m_resp_pending -= 1;
+
+                // Overtook an older request?
+                for (int i=0;i<(1 << AXI4_ID_W);i++)
+                    if (id_q[i].size() > 0 && id_q[i].front().seq < resp.seq)
+                    {
+                        m_reordered++;
+                        break;
+                    }
            }
         }
 
@@ -337,13 +405,90 @@ void tb_axi4_driver::read(uint32_t addr, uint8_t *data, int length)
             req_q.pop();
         }
 
-        axi_o.RREADY = !delay_cycle();
+        axi_o.RREADY = !delay_cycle() && !rready_throttle();
         axi_out.write(axi_o);
 
         wait();      
     }    
 }
 //-----------------------------------------------------------------
+// write_burst: Write a single AXI burst (len = AWLEN, beats of 4 bytes)
+//-----------------------------------------------------------------
+void tb_axi4_driver::write_burst(uint32_t addr, uint8_t *data, int len, int burst, int id)
+{
+    std::queue <axi4_master> req_q;
+    std::queue <axi4_master> resp_q;
+
+    sc_assert(!(addr & 3));
+    sc_assert(len >= 0 && len <= 255);
+
+    for (int i=0;i<=len;i++)
+    {
+        axi4_master req;
+
+        uint32_t word_data = 0;
+        for (int x=0;x<4;x++)
+            word_data |= (((uint32_t)*data++) << (8 *x));
+
+        // Address phase on first beat only
+        if (i == 0)
+        {
+            req.AWVALID = true;
+            req.AWADDR  = addr;
+            req.AWBURST = burst;
+            req.AWLEN   = len;
+        }
+
+        req.AWID    = id;
+        req.WVALID  = true;
+        req.WDATA   = word_data;
+        req.WSTRB   = 0xF;
+        req.WLAST   = (i == len);
+        req.BREADY  = true;
+
+        req_q.push(req);
+
+        if (req.WLAST)
+            resp_q.push(req);
+    }
+
+    write_issue(req_q, resp_q);
+}
+//-----------------------------------------------------------------
+// read_burst: Read a single AXI burst (len = ARLEN, beats of 4 bytes)
+//-----------------------------------------------------------------
+void tb_axi4_driver::read_burst(uint32_t addr, uint8_t *data, int len, int burst, int id)
+{
+    std::queue <axi4_master> req_q;
+    std::queue <axi_resp_t>  resp_q;
+
+    sc_assert(!(addr & 3));
+    sc_assert(len >= 0 && len <= 255);
+
+    axi4_master req;
+    req.ARVALID = true;
+    req.ARADDR  = addr;
+    req.ARID    = id;
+    req.ARBURST = burst;
+    req.ARLEN   = len;
+    req_q.push(req);
+
+    // Beats are returned in burst order (data is stored in that order)
+    for (int i=0;i<=len;i++)
+    {
+        axi_resp_t resp;
+        resp.addr = 0;
+        resp.size = 4;
+        resp.id   = id;
+        resp.last = (i == len);
+        resp.offset = i * 4;
+        resp.seq  = 0;
+        resp_q.push(resp);
+    }
+
+    read_issue(req_q, resp_q, data);
+}
+//-----------------------------------------------------------------
 // write32: Write a 32-bit word (must be aligned)
 //-----------------------------------------------------------------
 void tb_axi4_driver::write32(uint32_t addr, uint32_t data)
@@ -4,6 +4,20 @@
 #include "axi4_defines.h"
 #include "axi4.h"
 #include "tb_driver_api.h"
+#include <queue>
+
+//-------------------------------------------------------------
+// axi_resp_t: Expected read response beat
+//-------------------------------------------------------------
+typedef struct axi_resp_s
+{
+    uint32_t addr;
+    uint32_t size;
+    uint32_t id;
+    uint32_t last;
+    uint32_t offset;    // Byte offset into the read buffer
+    uint32_t seq;       // Request issue order
+} axi_resp_t;
 
 //-------------------------------------------------------------
 // tb_axi4_driver: AXI4 driver interface
@@ -28,6 +42,10 @@ public:
         m_min_id        = 0;
         m_max_id        = 15;
         m_resp_pending  = 0;
+        m_reordered     = 0;
+        m_first_resp    = SC_ZERO_TIME;
+        m_rready_throttle = 0;
+        m_wdata_first   = false;
     }
 
     //-------------------------------------------------------------
@@ -75,10 +93,29 @@ public:
     void         write(uint32_t addr, uint8_t *data, int length);
     void         read(uint32_t addr, uint8_t *data, int length);
 
+    // Single burst with explicit AxLEN / AxBURST / AxID
+    void         write_burst(uint32_t addr, uint8_t *data, int len, int burst, int id);
+    void         read_burst(uint32_t addr, uint8_t *data, int len, int burst, int id);
+
     bool         delay_cycle(void) { return m_enable_delays ? rand() & 1 : 0; }
 
+    // Read backpressure: RREADY low on pct% of cycles (independent of delays)
+    void         set_rready_throttle(int pct) { m_rready_throttle = pct; }
+    bool         rready_throttle(void) { return m_rready_throttle && (rand() % 100) < m_rready_throttle; }
+
+    // Write data ahead of its address on some bursts (W before AW)
+    void         set_wdata_first(bool enable) { m_wdata_first = enable; }
+
+    // Read bursts which completed ahead of an older request (other ID)
+    uint32_t     reordered_reads(void) { return m_reordered; }
+
+    // Time of the first read beat (critical word) of the last read
+    sc_time      first_resp_time(void) { return m_first_resp; }
+
 protected:
     void         write_internal(uint32_t addr, uint8_t *data, int length, uint8_t initial_mask);
+    void         write_issue(std::queue <axi4_master> &req_q, std::queue <axi4_master> &resp_q);
+    void         read_issue(std::queue <axi4_master> &req_q, std::queue <axi_resp_t> &resp_q, uint8_t *data);
 
     //-------------------------------------------------------------
     // Members
@@ -89,6 +126,10 @@ protected:
     int  m_max_id;
 
     uint32_t m_resp_pending;
+    uint32_t m_reordered;
+    sc_time  m_first_resp;
+    int      m_rready_throttle;
+    bool     m_wdata_first;
 };
 
 #endif
\ No newline at end of file
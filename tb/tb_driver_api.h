@@ -1,6 +1,7 @@
 #ifndef TB_DRIVER_API_H
 #define TB_DRIVER_API_H
 
+#include <systemc.h>
 #include <stdio.h>
 #include <unistd.h>
 
@@ -14,6 +15,9 @@ public:
     virtual uint32_t  read32(uint32_t addr) = 0;
     virtual void      write(uint32_t addr, uint8_t *data, int length) = 0;
     virtual void      read(uint32_t addr, uint8_t *data, int length) = 0;
+
+    // Time as seen by the driver (differs from sim time for decoupled drivers)
+    virtual sc_time   local_time(void) { return sc_time_stamp(); }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,254 @@
+#include "tb_mem_bench.h"
+#include "tb_axi4_driver.h"
+#include "sdram_config.h"
+
+// RBC mapping: next row in the same bank
+#define ROW_STRIDE        (1 << (SDRAM_COL_W + 3))
+
+#define BLOCK_SIZE        256
+#define STRIDE            1024
+#define MIXED_WRITE_RATIO 3     // 1 in 3 accesses are writes
+#define LINE_SIZE         32    // Cache line (WRAP burst of 8 beats)
+#define WRITE_MIX_SIZE    59    // 4B, 32B, 16B, 4B bursts then a byte write
+
+//-----------------------------------------------------------------
+// Benchmarks
+//-----------------------------------------------------------------
+enum
+{
+    BENCH_SEQ_READ,
+    BENCH_SEQ_WRITE,
+    BENCH_COPY,
+    BENCH_STRIDED,
+    BENCH_RANDOM_4B,
+    BENCH_RANDOM_32B,
+    BENCH_MIXED_RW,
+    BENCH_BANK_CONFLICT,
+    BENCH_CACHE_FILL,
+    BENCH_WRITE_MIX,
+    BENCH_MAX
+};
+
+static const char *bench_names[BENCH_MAX] =
+{
+    "seq_read",
+    "seq_write",
+    "copy",
+    "strided",
+    "random_4b",
+    "random_32b",
+    "mixed_rw",
+    "bank_conflict",
+    "cache_fill",
+    "write_mix"
+};
+
+//-----------------------------------------------------------------
+// valid_name: Known benchmark (or 'all')
+//-----------------------------------------------------------------
+bool tb_mem_bench::valid_name(std::string name)
+{
+    if (name == "all")
+        return true;
+
+    for (int i=0;i<BENCH_MAX;i++)
+        if (name == bench_names[i])
+            return true;
+
+    return false;
+}
+//-----------------------------------------------------------------
+// rand_addr: Random aligned address within the first region
+//-----------------------------------------------------------------
+uint32_t tb_mem_bench::rand_addr(int length, int alignment)
+{
+    uint32_t base = m_mem[0]->get_base();
+    uint32_t size = m_mem[0]->get_size();
+
+    return base + ((rand() % (size - length)) & ~(alignment - 1));
+}
+//-----------------------------------------------------------------
+// do_read: Timed block read, checked against shadow memory
+//-----------------------------------------------------------------
+void tb_mem_bench::do_read(uint32_t addr, int length, uint8_t *buffer)
+{
+    uint8_t local[BLOCK_SIZE];
+    if (!buffer)
+        buffer = local;
+
+    sc_assert(length <= BLOCK_SIZE);
+
+    sc_time t_issue = m_driver->local_time();
+    m_driver->read(addr, buffer, length);
+    m_stats.record(false, length, (length + 3) / 4, t_issue, m_driver->local_time());
+
+    for (int i=0;i<length;i++)
+    {
+        if (this->read(addr + i) != buffer[i])
+            printf("MISMATCH: %08x -> %02x != %02x\n", addr + i, buffer[i], this->read(addr + i));
+        sc_assert(this->read(addr + i) == buffer[i]);
+    }
+}
+//-----------------------------------------------------------------
+// do_write: Timed block write (random data unless supplied)
+//-----------------------------------------------------------------
+void tb_mem_bench::do_write(uint32_t addr, int length, uint8_t *buffer)
+{
+    uint8_t local[BLOCK_SIZE];
+    if (!buffer)
+    {
+        buffer = local;
+        for (int i=0;i<length;i++)
+            buffer[i] = rand();
+    }
+
+    sc_assert(length <= BLOCK_SIZE);
+
+    for (int i=0;i<length;i++)
+        this->write(addr + i, buffer[i]);
+
+    sc_time t_issue = m_driver->local_time();
+    m_driver->write(addr, buffer, length);
+    m_stats.record(true, length, (length + 3) / 4, t_issue, m_driver->local_time());
+}
+//-----------------------------------------------------------------
+// do_fill: Cache line fill, WRAP burst starting at the critical word
+//-----------------------------------------------------------------
+void tb_mem_bench::do_fill(tb_axi4_driver *axi, uint32_t addr)
+{
+    uint8_t  buffer[LINE_SIZE];
+    uint32_t line = addr & ~(LINE_SIZE - 1);
+
+    sc_time t_issue = m_driver->local_time();
+    axi->read_burst(addr, buffer, (LINE_SIZE / 4) - 1, AXI4_BURST_WRAP, rand() % (1 << AXI4_ID_W));
+    m_stats.record(false, LINE_SIZE, LINE_SIZE / 4, t_issue, m_driver->local_time());
+    m_cw_stats.record(false, 4, 1, t_issue, axi->first_resp_time());
+
+    // Beats are in wrap order
+    for (int i=0;i<LINE_SIZE;i++)
+    {
+        uint32_t beat_addr = line + (((addr - line) + i) % LINE_SIZE);
+
+        if (this->read(beat_addr) != buffer[i])
+            printf("MISMATCH: %08x -> %02x != %02x\n", beat_addr, buffer[i], this->read(beat_addr));
+        sc_assert(this->read(beat_addr) == buffer[i]);
+    }
+}
+//-----------------------------------------------------------------
+// run: Execute a single benchmark
+//-----------------------------------------------------------------
+void tb_mem_bench::run(int idx)
+{
+    uint32_t base = m_mem[0]->get_base();
+    uint32_t size = m_mem[0]->get_size();
+    uint32_t half = size / 2;
+
+    // WRAP bursts + critical word timing need the RTL AXI driver
+    tb_axi4_driver *axi = dynamic_cast<tb_axi4_driver *>(m_driver);
+    if (idx == BENCH_CACHE_FILL && !axi)
+    {
+        printf("BENCH: %s skipped (needs the AXI driver)\n", bench_names[idx]);
+        return;
+    }
+
+    m_stats.reset(bench_names[idx]);
+    m_cw_stats.reset(std::string(bench_names[idx]) + "_cw");
+
+    sc_clock *clk = dynamic_cast<sc_clock *>(clk_in.get_interface());
+    if (clk)
+    {
+        m_stats.set_period(clk->period());
+        m_cw_stats.set_period(clk->period());
+    }
+
+    m_stats.start(m_driver->local_time());
+    m_cw_stats.start(m_driver->local_time());
+
+    for (int i=0;i<m_ops;i++)
+    {
+        switch (idx)
+        {
+            case BENCH_SEQ_READ:
+                do_read(base + ((i * BLOCK_SIZE) % size), BLOCK_SIZE);
+                break;
+            case BENCH_SEQ_WRITE:
+                do_write(base + ((i * BLOCK_SIZE) % size), BLOCK_SIZE);
+                break;
+            case BENCH_COPY:
+            {
+                uint8_t  buffer[BLOCK_SIZE];
+                uint32_t offset = (i * BLOCK_SIZE) % half;
+
+                do_read(base + offset, BLOCK_SIZE, buffer);
+                do_write(base + half + offset, BLOCK_SIZE, buffer);
+            }
+            break;
+            case BENCH_STRIDED:
+                do_read(base + ((i * STRIDE) % size), 32);
+                break;
+            case BENCH_RANDOM_4B:
+                do_read(rand_addr(4, 4), 4);
+                break;
+            case BENCH_RANDOM_32B:
+                do_read(rand_addr(32, 32), 32);
+                break;
+            case BENCH_MIXED_RW:
+            {
+                uint32_t addr = rand_addr(32, 32);
+                if ((rand() % MIXED_WRITE_RATIO) == 0)
+                    do_write(addr, 32);
+                else
+                    do_read(addr, 32);
+            }
+            break;
+            case BENCH_BANK_CONFLICT:
+            {
+                // Same bank, alternating rows -> row miss every access
+                uint32_t offset = ((i >> 1) * 32) % (1 << (SDRAM_COL_W + 1));
+                do_read(base + ((i & 1) ? ROW_STRIDE : 0) + offset, 32);
+            }
+            break;
+            case BENCH_CACHE_FILL:
+                do_fill(axi, rand_addr(LINE_SIZE, LINE_SIZE) + (rand() % (LINE_SIZE / 4)) * 4);
+                break;
+            case BENCH_WRITE_MIX:
+            {
+                // Single beat and multi-beat write bursts back to back,
+                // starting one word below a 32B boundary, then read back
+                uint32_t addr = rand_addr(WRITE_MIX_SIZE + LINE_SIZE, LINE_SIZE) + LINE_SIZE - 4;
+                do_write(addr, WRITE_MIX_SIZE);
+                do_read(addr, WRITE_MIX_SIZE);
+            }
+            break;
+        }
+    }
+
+    m_stats.stop(m_driver->local_time());
+    m_stats.report();
+
+    // Critical word latency (first beat of each fill)
+    if (idx == BENCH_CACHE_FILL)
+    {
+        m_cw_stats.stop(m_driver->local_time());
+        m_cw_stats.report();
+    }
+}
+//-----------------------------------------------------------------
+// process: Run selected benchmark(s)
+//-----------------------------------------------------------------
+void tb_mem_bench::process(void)
+{
+    while (true)
+    {
+        m_enabled.wait();
+        printf("Starting benchmark %s (%d ops)...\n", m_name.c_str(), m_ops);
+
+        for (int i=0;i<BENCH_MAX;i++)
+            if (m_name == "all" || m_name == bench_names[i])
+                run(i);
+
+        // Notify completion
+        printf("Completed benchmark...\n");
+        m_completed.post();
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef TB_MEM_BENCH_H
+#define TB_MEM_BENCH_H
+
+#include <systemc.h>
+#include <string>
+#include "tb_driver_api.h"
+#include "tb_memory.h"
+#include "tb_perf_stats.h"
+
+class tb_axi4_driver;
+
+//-------------------------------------------------------------
+// tb_mem_bench: Named access pattern benchmarks (using driver)
+//
+// Closed-loop: each operation is one blocking driver call, which
+// issues its bursts back to back (a 256 byte block is 8 x 32 byte
+// bursts in flight) but drains them all before returning. Single
+// burst benchmarks (random_4b, random_32b, mixed_rw, bank_conflict,
+// cache_fill, strided) therefore have one transaction outstanding, and
+// their MB/s is bound by round-trip latency rather than controller
+// throughput or AXI_REQ_DEPTH.
+//-------------------------------------------------------------
+class tb_mem_bench: public sc_module, public tb_memory
+{
+public:
+    //-------------------------------------------------------------
+    // Interface I/O
+    //-------------------------------------------------------------
+    sc_in <bool>             clk_in;
+    sc_in <bool>             rst_in;
+
+    //-------------------------------------------------------------
+    // Constructor
+    //-------------------------------------------------------------
+    SC_HAS_PROCESS(tb_mem_bench);
+    tb_mem_bench(sc_module_name name, tb_driver_api *iface): sc_module(name)
+                                                           , m_enabled("enabled", 0)
+                                                           , m_completed("completed", 0)
+    {
+        SC_CTHREAD(process, clk_in.pos());
+        m_driver = iface;
+        m_ops    = 1000;
+    }
+
+    // API
+    void start(std::string name, int ops = 1000)
+    {
+        m_name = name;
+        m_ops  = ops;
+        m_enabled.post();
+    }
+
+    void wait_complete(void) { m_completed.wait(); }
+
+    void set_driver(tb_driver_api *iface) { m_driver = iface; }
+
+    static bool valid_name(std::string name);
+
+    // Internal
+protected:
+    void         do_read(uint32_t addr, int length, uint8_t *buffer = NULL);
+    void         do_write(uint32_t addr, int length, uint8_t *buffer = NULL);
+    void         do_fill(tb_axi4_driver *axi, uint32_t addr);
+    uint32_t     rand_addr(int length, int alignment);
+    void         run(int idx);
+    void         process(void);
+
+protected:
+    sc_semaphore     m_enabled;
+    sc_semaphore     m_completed;
+    tb_driver_api *  m_driver;
+    std::string      m_name;
+    int              m_ops;
+    tb_perf_stats    m_stats;
+    tb_perf_stats    m_cw_stats;
+};
+
+#endif
@@ -39,6 +39,8 @@ public:
 
     void wait_complete(void) { m_completed.wait(); }
 
+    void set_driver(tb_driver_api *iface) { m_driver = iface; }
+
     void trace_access(bool en)
     {
         for (int i=0;i<TB_MEM_MAX_REGIONS;i++)
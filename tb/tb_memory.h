@@ -187,6 +187,49 @@ public:
         return NULL;
     }
 
+    //-------------------------------------------------------------
+    // Checkpoint: region layout + contents (T = VerilatedSerialize)
+    //-------------------------------------------------------------
+    template <class T> void save(T &os)
+    {
+        for (int i=0;i<TB_MEM_MAX_REGIONS;i++)
+        {
+            uint32_t base = m_mem[i] ? m_mem[i]->get_base() : 0;
+            uint32_t size = m_mem[i] ? m_mem[i]->get_size() : 0;
+
+            os.write(&base, sizeof(base));
+            os.write(&size, sizeof(size));
+            if (size)
+                os.write(m_mem[i]->get_array(), size);
+        }
+    }
+
+    // Regions must already be allocated with the same layout
+    template <class T> bool restore(T &is)
+    {
+        for (int i=0;i<TB_MEM_MAX_REGIONS;i++)
+        {
+            uint32_t base = 0;
+            uint32_t size = 0;
+
+            is.read(&base, sizeof(base));
+            is.read(&size, sizeof(size));
+
+            if (!m_mem[i])
+            {
+                if (size)
+                    return false;
+            }
+            else if (base != m_mem[i]->get_base() || size != m_mem[i]->get_size())
+                return false;
+
+            if (size)
+                is.read(m_mem[i]->get_array(), size);
+        }
+
+        return true;
+    }
+
     void          records_enable(bool enable) { m_record_accesses = enable; }
     bool          records_available(void)     { return m_accesses.size() != 0; }
     tb_mem_record records_pop(void)           { tb_mem_record v = m_accesses.front(); m_accesses.pop(); return v; }
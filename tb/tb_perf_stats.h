@@ -0,0 +1,126 @@
+#ifndef TB_PERF_STATS_H
+#define TB_PERF_STATS_H
+
+#include <systemc.h>
+#include <vector>
+#include <algorithm>
+#include <string>
+
+//-----------------------------------------------------------------
+// tb_perf_stats: Bandwidth / latency accounting for sequencers
+//-----------------------------------------------------------------
+class tb_perf_stats
+{
+public:
+    tb_perf_stats(std::string name = "perf") { reset(name); }
+
+    void reset(std::string name)
+    {
+        m_name        = name;
+        m_bytes_rd    = 0;
+        m_bytes_wr    = 0;
+        m_beats       = 0;
+        m_txns        = 0;
+        m_late        = 0;
+        m_period      = sc_time(1, SC_NS);
+        m_latency.clear();
+    }
+
+    // Clock period used to convert times to cycles
+    void    set_period(sc_time period) { m_period = period; }
+    sc_time period(void)               { return m_period; }
+
+    void start(sc_time t = sc_time_stamp()) { m_start = t; }
+    void stop(sc_time t = sc_time_stamp())  { m_end   = t; }
+
+    // Record a completed transaction (issued at t_issue, ending at t_done)
+    void record(bool write, uint32_t bytes, uint32_t beats, sc_time t_issue, sc_time t_done = sc_time_stamp())
+    {
+        if (write)
+            m_bytes_wr += bytes;
+        else
+            m_bytes_rd += bytes;
+
+        m_beats += beats;
+        m_txns  += 1;
+        m_latency.push_back((t_done - t_issue) / m_period);
+    }
+
+    // Transaction issued later than its requested time
+    void record_late(void) { m_late += 1; }
+
+    double   cycles(void)    { return (m_end - m_start) / m_period; }
+    double   seconds(void)   { return (m_end - m_start).to_seconds(); }
+    uint64_t bytes(void)     { return m_bytes_rd + m_bytes_wr; }
+
+    double mbps(void)
+    {
+        double s = seconds();
+        return s > 0 ? (bytes() / s) / 1000000.0 : 0.0;
+    }
+
+    // AXI data bus utilisation (beats per cycle)
+    double utilisation(void)
+    {
+        double c = cycles();
+        return c > 0 ? m_beats / c : 0.0;
+    }
+
+    double latency_mean(void)
+    {
+        if (m_latency.empty())
+            return 0.0;
+
+        double total = 0;
+        for (size_t i=0;i<m_latency.size();i++)
+            total += m_latency[i];
+        return total / m_latency.size();
+    }
+
+    double latency_percentile(double pct)
+    {
+        if (m_latency.empty())
+            return 0.0;
+
+        std::vector <double> sorted = m_latency;
+        std::sort(sorted.begin(), sorted.end());
+
+        size_t idx = (size_t)((pct / 100.0) * (sorted.size() - 1) + 0.5);
+        return sorted[idx];
+    }
+
+    //-------------------------------------------------------------
+    // report: Single line, key=value (machine readable)
+    //-------------------------------------------------------------
+    void report(void)
+    {
+        printf("PERF: name=%s txns=%llu bytes_rd=%llu bytes_wr=%llu cycles=%.0f mbps=%.2f util=%.3f lat_mean=%.2f lat_p99=%.0f lat_max=%.0f late=%llu\n",
+                m_name.c_str(),
+                (unsigned long long)m_txns,
+                (unsigned long long)m_bytes_rd,
+                (unsigned long long)m_bytes_wr,
+                cycles(),
+                mbps(),
+                utilisation(),
+                latency_mean(),
+                latency_percentile(99.0),
+                latency_percentile(100.0),
+                (unsigned long long)m_late);
+    }
+
+protected:
+    std::string          m_name;
+    sc_time              m_period;
+    sc_time              m_start;
+    sc_time              m_end;
+
+    uint64_t             m_bytes_rd;
+    uint64_t             m_bytes_wr;
+    uint64_t             m_beats;
+    uint64_t             m_txns;
+    uint64_t             m_late;
+
+    std::vector <double> m_latency;
+};
+
+#endif
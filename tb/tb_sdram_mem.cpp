@@ -1,52 +1,119 @@
 #include "tb_sdram_mem.h"
+#include "sdram_config.h"
 #include <queue>
 
-#define SDRAM_COL_W   9
-#define SDRAM_BANK_W  2
-#define SDRAM_ROW_W   13
-#define NUM_ROWS      (1 << SDRAM_ROW_W)
+// Power-up delay before the first command (RTL cycles, SDRAM_START_DELAY)
+#ifdef SDRAM_FAST_INIT
+    #define MIN_POWERUP_CYCLES    0
+#else
+    #define MIN_POWERUP_CYCLES    (100000 / (1000 / SDRAM_MHZ))
+#endif
 
-// REF: https://www.micron.com/~/media/documents/products/data-sheet/dram/128mb_x4x8x16_ait-aat_sdram.pdf
+#define DPRINTF //printf
 
-#define MAX_ROW_OPEN_TIME     sc_time(35, SC_US)
-#define MIN_ACTIVE_TO_ACTIVE  sc_time(60, SC_NS)
-#define MIN_ACTIVE_TO_ACCESS  sc_time(15, SC_NS)
-#define MAX_ROW_REFRESH_TIME  (sc_time((64000000 / NUM_ROWS), SC_NS) + sc_time(200, SC_NS)) // Add some slack (FIXME) 
+//-----------------------------------------------------------------
+// set_profile: Geometry + timing rules (NULL = build defaults)
+//-----------------------------------------------------------------
+bool tb_sdram_mem::set_profile(const char *name)
+{
+    const sdram_speed_grade *grade = sdram_speed_grade_find(SDRAM_SPEED_GRADE);
 
-#define DPRINTF //printf
+    if (!name)
+    {
+        m_col_w  = SDRAM_COL_W;
+        m_row_w  = SDRAM_ROW_W;
+        m_bank_w = SDRAM_BANK_W;
+    }
+    else
+    {
+        const sdram_profile *p = sdram_profile_find(name);
+        if (!p)
+        {
+            printf("ERROR: Unknown SDRAM profile %s\n", name);
+            sdram_profile_list();
+            return false;
+        }
+
+        if (!sdram_profile_supported(p))
+            return false;
+
+        m_col_w  = p->col_w;
+        m_row_w  = p->row_w;
+        m_bank_w = p->bank_w;
+        grade    = sdram_profile_grade(p);
+
+        printf("SDRAM: profile=%s rows=%d cols=%d banks=%d ranks=%d\n", p->name, 1 << m_row_w, 1 << m_col_w, 1 << m_bank_w, SDRAM_RANKS);
+    }
+
+    m_banks = SDRAM_RANKS << m_bank_w;
+    sc_assert(SDRAM_RANKS <= MAX_RANKS && m_banks <= MAX_BANKS);
+
+    for (uint32_t r=0;r<SDRAM_RANKS;r++)
+        m_timing[r].configure(grade, SDRAM_MHZ, m_row_w, 1 << m_bank_w);
+
+    return true;
+}
+//-----------------------------------------------------------------
+// set_board_delay: Read data arrives CAS latency + cycles after READ
+//-----------------------------------------------------------------
+void tb_sdram_mem::set_board_delay(int cycles)
+{
+    sc_assert(cycles >= 0 && cycles <= MAX_BOARD_DELAY);
+    m_board_delay = cycles;
 
+    printf("SDRAM: board_delay=%d\n", m_board_delay);
+}
+//-----------------------------------------------------------------
+// set_channel: Tag statistics with the channel number
+//-----------------------------------------------------------------
+void tb_sdram_mem::set_channel(int ch)
+{
+    char tag[16];
+    sprintf(tag, "SDRAM%d", ch);
+    m_stats_tag = tag;
+}
+//-----------------------------------------------------------------
+// map_addr: Address = R{rank,bank}C
+//-----------------------------------------------------------------
+uint32_t tb_sdram_mem::map_addr(uint32_t row, uint32_t bank, uint32_t col)
+{
+    uint32_t col_mask = (1 << m_col_w) - 1;
+    uint32_t row_mask = (1 << m_row_w) - 1;
+
+    return (((col & col_mask) >> 1) << 2) |
+           (bank << (m_col_w + 1)) |
+           ((row & row_mask) << (m_col_w + m_bank_w + SDRAM_RANK_W + 1));
+}
+//-----------------------------------------------------------------
+// bank_index: {rank, bank} for a command to a single rank
+//-----------------------------------------------------------------
+uint32_t tb_sdram_mem::bank_index(uint32_t ranks, uint32_t ba)
+{
+    // Bank commands select exactly one rank
+    sc_assert(ranks && !(ranks & (ranks - 1)));
+
+    uint32_t rank = 0;
+    while (!((ranks >> rank) & 1))
+        rank++;
+
+    return (rank << m_bank_w) | ba;
+}
 //-----------------------------------------------------------------
 // process: Handle requests
 //-----------------------------------------------------------------
 void tb_sdram_mem::process(void)
 {
-    typedef enum
-    {
-        SDRAM_CMD_INHIBIT = 0,
-        SDRAM_CMD_NOP,
-        SDRAM_CMD_ACTIVE,
-        SDRAM_CMD_READ,
-        SDRAM_CMD_WRITE,
-        SDRAM_CMD_BURST_TERM,
-        SDRAM_CMD_PRECHARGE,
-        SDRAM_CMD_REFRESH,
-        SDRAM_CMD_LOAD_MODE
-    } t_sdram_cmd;
-
-    sc_uint <SDRAM_COL_W>  col = 0;
-    sc_uint <SDRAM_ROW_W>  row = 0;
-    sc_uint <SDRAM_BANK_W> bank = 0;
-    sc_uint <32>           addr = 0;
-
-    uint16_t resp_data[3];
+    uint32_t col  = 0;
+    uint32_t row  = 0;
+    uint32_t bank = 0;
+    uint32_t addr = 0;
+
+    uint16_t resp_data[3 + MAX_BOARD_DELAY];
 
     // Clear response pipeline
     for (int i=0;i<sizeof(resp_data)/sizeof(resp_data[0]);i++)
         resp_data[i] = 0;
 
-    for (unsigned b=0;b<NUM_BANKS;b++)
-        m_activate_time[b] = sc_time_stamp();
-
     m_refresh_cnt = 0;
     while (1)
     {
@@ -55,8 +122,12 @@ void tb_sdram_mem::process(void)
 
         t_sdram_cmd new_cmd;
 
+        // Selected ranks (CS low)
+        uint32_t all_ranks = (1 << SDRAM_RANKS) - 1;
+        uint32_t ranks     = ~sdram_i.CS & all_ranks;
+
         // Command decoder
-        if (sdram_i.CS)
+        if (!ranks)
             new_cmd = SDRAM_CMD_INHIBIT;
         else
         {
@@ -80,21 +151,33 @@ void tb_sdram_mem::process(void)
                 sc_assert(0); // NOT SURE...
         }
 
-        // Check row open time...
-        for (unsigned b = 0;b < NUM_BANKS;b++)
-            if (m_active_row[b] != -1 && (sc_time_stamp() - m_activate_time[b]) > MAX_ROW_OPEN_TIME)
-            {
-                sc_assert(!"Row open too long...");
-            }
+        m_stat_cycles++;
+        m_stat_cmd[new_cmd]++;
+
+        // Power-up: CKE high and 100uS (or fast init) before first command
+        if (!m_powered_up && new_cmd != SDRAM_CMD_INHIBIT && new_cmd != SDRAM_CMD_NOP)
+        {
+            sc_assert(sdram_i.CKE);
+            sc_assert(m_stat_cycles >= MIN_POWERUP_CYCLES);
+            m_powered_up = true;
+        }
+
+        // Command timing (tRCD, tRP, tRAS, tRC, tRRD, tWR, tRFC, tREFI, tMRD), per rank
+        for (uint32_t r=0;r<SDRAM_RANKS;r++)
+            if (!m_timing[r].check(sdram_timing_checker::decode((sdram_i.CS >> r) & 1, sdram_i.RAS, sdram_i.CAS, sdram_i.WE), sdram_i.BA, sdram_i.ADDR))
+                sc_assert(!"SDRAM timing violation");
 
         // Configure SDRAM
         if (new_cmd == SDRAM_CMD_LOAD_MODE)
         {
+            // All ranks share one mode
+            sc_assert(ranks == all_ranks);
+
             m_configured      = true;
-            m_burst_type      = (tBurstType)(int)sdram_i.ADDR[3];
-            m_write_burst_en  = (bool)!sdram_i.ADDR[9];
-            m_burst_length    = (tBurstLength)(int)sdram_i.ADDR.range(2,0);
-            m_cas_latency     = (int)sdram_i.ADDR.range(6,4);
+            m_burst_type      = (tBurstType)((sdram_i.ADDR >> 3) & 1);
+            m_write_burst_en  = !((sdram_i.ADDR >> 9) & 1);
+            m_burst_length    = (tBurstLength)(sdram_i.ADDR & 0x7);
+            m_cas_latency     = (sdram_i.ADDR >> 4) & 0x7;
 
             DPRINTF("SDRAM: MODE - write burst %d, burst len %d, CAS latency %d\n", m_write_burst_en, m_burst_length, m_cas_latency);
 
@@ -103,21 +186,26 @@ void tb_sdram_mem::process(void)
         // Auto refresh
         else if (new_cmd == SDRAM_CMD_REFRESH)
         {
-            //cout << "SDRAM: REFRESH @ " << sc_time_stamp() << " - delta = " << (sc_time_stamp() - m_last_refresh) << " - allowed " << MAX_ROW_REFRESH_TIME <<endl;
-
-            // Check no rows open..
-            for (unsigned b = 0;b < NUM_BANKS;b++)
+            // Check no rows open (in the refreshed ranks)..
+            for (unsigned b = 0;b < m_banks;b++)
             {
-                sc_assert(m_active_row[b] == -1);
+                if ((ranks >> (b >> m_bank_w)) & 1)
+                    sc_assert(m_active_row[b] == -1);
             }
 
-            // Once init sequence complete, check for auto-refresh period...
+            // Once init sequence complete, record auto-refresh period...
             if (m_refresh_cnt > 2)
             {
-                sc_assert((sc_time_stamp() - m_last_refresh) < MAX_ROW_REFRESH_TIME);
+                uint64_t interval = m_stat_cycles - m_stat_refresh_last;
+                if (m_stat_refresh_cnt == 0 || interval < m_stat_refresh_min)
+                    m_stat_refresh_min = interval;
+                if (interval > m_stat_refresh_max)
+                    m_stat_refresh_max = interval;
+                m_stat_refresh_total += interval;
+                m_stat_refresh_cnt   += 1;
             }
 
-            m_last_refresh = sc_time_stamp();
+            m_stat_refresh_last = m_stat_cycles;
 
             if (m_refresh_cnt < 0xFFFFFFFF)
                 m_refresh_cnt += 1;
@@ -128,29 +216,34 @@ void tb_sdram_mem::process(void)
             sc_assert(m_configured);
             sc_assert(m_refresh_cnt >= 2);
 
-            bank = sdram_i.BA;
-            row  = sdram_i.ADDR;
+            bank = bank_index(ranks, sdram_i.BA);
+            row  = sdram_i.ADDR & ((1 << m_row_w) - 1);
 
             DPRINTF("SDRAM: ACTIVATE Row=%x, Bank=%x\n", (unsigned)row, (unsigned)bank);
 
             // A row should not be open
             sc_assert(m_active_row[bank] == -1);
 
-            // ACTIVATE periods long enough...
-            sc_assert((sc_time_stamp() - m_activate_time[bank]) > MIN_ACTIVE_TO_ACTIVE);
-
             // Mark row as open
             m_active_row[bank]    = row;
-            m_activate_time[bank] = sc_time_stamp();
+
+            // Row closed to make way for this one, or bank was idle
+            if (m_row_evicted[bank])
+                m_stat_row_conflict[bank]++;
+            else
+                m_stat_row_empty[bank]++;
+
+            m_row_evicted[bank]  = false;
+            m_row_accessed[bank] = false;
         }
         // Read command
         else if (new_cmd == SDRAM_CMD_READ)
         {
             sc_assert(m_configured);
 
-            bool en_ap = sdram_i.ADDR[SDRAM_COL_W];
-            col        = sdram_i.ADDR;
-            bank       = sdram_i.BA;
+            bool en_ap = (sdram_i.ADDR >> 10) & 1;
+            col        = sdram_i.ADDR & ((1 << m_col_w) - 1);
+            bank       = bank_index(ranks, sdram_i.BA);
             row        = m_active_row[bank];
 
             // A row should be open
@@ -159,20 +252,18 @@ void tb_sdram_mem::process(void)
             // DQM expected to be low
             sc_assert(sdram_i.DQM == 0x0);
 
-            // Check row activate timing
-            sc_assert((sc_time_stamp() - m_activate_time[bank]) > MIN_ACTIVE_TO_ACCESS);
+            if (m_row_accessed[bank])
+                m_stat_row_hit[bank]++;
+            m_row_accessed[bank] = true;
 
-            // Address = RBC
-            addr.range(SDRAM_COL_W, 2)                                       = col.range(SDRAM_COL_W-1, 1);
-            addr.range(SDRAM_COL_W+SDRAM_BANK_W, SDRAM_COL_W+SDRAM_BANK_W-1) = bank;
-            addr.range(31, SDRAM_COL_W+SDRAM_BANK_W+1) = row;
+            addr = map_addr(row, bank, col);
 
             m_burst_offset = 0;
 
             uint32_t data = read32((uint32_t)addr);
             DPRINTF("SDRAM: READ %08x = %08x [Row=%x, Bank=%x, Col=%x]\n", (uint32_t)addr, data, (unsigned)row, (unsigned)bank, (unsigned)col);
 
-            resp_data[m_cas_latency-2] = data >> (m_burst_offset * 8);
+            resp_data[m_cas_latency-2+m_board_delay] = data >> (m_burst_offset * 8);
             m_burst_offset += 2;
 
             switch (m_burst_length)
@@ -199,21 +290,19 @@ void tb_sdram_mem::process(void)
         {
             sc_assert(m_configured);
 
-            bool en_ap = sdram_i.ADDR[SDRAM_COL_W];
-            col        = sdram_i.ADDR;
-            bank       = sdram_i.BA;
+            bool en_ap = (sdram_i.ADDR >> 10) & 1;
+            col        = sdram_i.ADDR & ((1 << m_col_w) - 1);
+            bank       = bank_index(ranks, sdram_i.BA);
             row        = m_active_row[bank];
 
             // A row should be open
             sc_assert(m_active_row[bank] != -1);
 
-            // Check row activate timing
-            sc_assert((sc_time_stamp() - m_activate_time[bank]) > MIN_ACTIVE_TO_ACCESS);
+            addr = map_addr(row, bank, col);
 
-            // Address = RBC
-            addr.range(SDRAM_COL_W, 2)                                       = col.range(SDRAM_COL_W-1, 1);
-            addr.range(SDRAM_COL_W+SDRAM_BANK_W, SDRAM_COL_W+SDRAM_BANK_W-1) = bank;
-            addr.range(31, SDRAM_COL_W+SDRAM_BANK_W+1) = row;
+            if (m_row_accessed[bank])
+                m_stat_row_hit[bank]++;
+            m_row_accessed[bank] = true;
 
             uint32_t data = (uint32_t)sdram_i.DATA_OUTPUT;
             uint8_t  mask = 0;
@@ -224,14 +313,14 @@ void tb_sdram_mem::process(void)
             mask = 0x3 << (m_burst_offset);
 
             // Lower byte - disabled
-            if (sdram_i.DQM[0])
+            if (sdram_i.DQM & 1)
             {
                 data &= ~(0xFF << ((m_burst_offset + 0) * 8));
                 mask &= ~(1 << (m_burst_offset + 0));
             }
 
             // Upper byte disabled
-            if (sdram_i.DQM[1])
+            if (sdram_i.DQM & 2)
             {
                 data &= ~(0xFF << ((m_burst_offset + 1) * 8));
                 mask &= ~(1 << (m_burst_offset + 1));
@@ -272,11 +361,17 @@ void tb_sdram_mem::process(void)
             sc_assert(m_configured);
 
             // All banks
-            if (sdram_i.ADDR[10])
+            if ((sdram_i.ADDR >> 10) & 1)
             {
-                // Close rows
-                for (unsigned i=0;i<NUM_BANKS;i++)
-                    m_active_row[i] = -1;
+                // Close rows (in the selected ranks)
+                for (unsigned i=0;i<m_banks;i++)
+                {
+                    if (!((ranks >> (i >> m_bank_w)) & 1))
+                        continue;
+
+                    m_active_row[i]  = -1;
+                    m_row_evicted[i] = false;
+                }
 
                 DPRINTF("SDRAM: PRECHARGE - all banks\n");
 
@@ -284,12 +379,13 @@ void tb_sdram_mem::process(void)
             // Specified bank
             else
             {
-                bank       = sdram_i.BA;
+                bank       = bank_index(ranks, sdram_i.BA);
 
                 DPRINTF("SDRAM: PRECHARGE Bank=%x, Active Row=%x\n", (unsigned)bank, (unsigned)m_active_row[bank]);
 
                 // Close specific row
-                m_active_row[bank] = -1;
+                m_row_evicted[bank] = (m_active_row[bank] != -1);
+                m_active_row[bank]  = -1;
             }
         }
         // Terminate read or write burst
@@ -301,9 +397,15 @@ void tb_sdram_mem::process(void)
             DPRINTF("SDRAM: Burst terminate\n");
         }
 
+        // Data bus occupied by the first beat of an access
+        if (new_cmd == SDRAM_CMD_READ || new_cmd == SDRAM_CMD_WRITE)
+            m_stat_data_busy++;
+
         // WRITE: Burst continuation...
         if (m_burst_write > 0 && new_cmd == SDRAM_CMD_NOP)
         {
+            m_stat_data_busy++;
+
             uint32_t data = (uint32_t)sdram_i.DATA_OUTPUT;
             uint8_t  mask = 0;
 
@@ -311,14 +413,14 @@ void tb_sdram_mem::process(void)
             mask = 0x3 << (m_burst_offset);
 
             // Lower byte - disabled
-            if (sdram_i.DQM[0])
+            if (sdram_i.DQM & 1)
             {
                 data &= ~(0xFF << ((m_burst_offset + 0) * 8));
                 mask &= ~(1 << (m_burst_offset + 0));
             }
 
             // Upper byte disabled
-            if (sdram_i.DQM[1])
+            if (sdram_i.DQM & 2)
             {
                 data &= ~(0xFF << ((m_burst_offset + 1) * 8));
                 mask &= ~(1 << (m_burst_offset + 1));
@@ -346,10 +448,12 @@ void tb_sdram_mem::process(void)
         // READ: Burst continuation
         else if (m_burst_read > 0 && new_cmd == SDRAM_CMD_NOP)
         {
+            m_stat_data_busy++;
+
             uint32_t data = read32((uint32_t)addr);
             DPRINTF("SDRAM: READ %08x = %08x [Row=%x, Bank=%x, Col=%x]\n", (uint32_t)addr, data, (unsigned)row, (unsigned)bank, (unsigned)col);
 
-            resp_data[m_cas_latency-2] = data >> (m_burst_offset * 8);
+            resp_data[m_cas_latency-2+m_board_delay] = data >> (m_burst_offset * 8);
             m_burst_offset += 2;
 
             // Continue...
@@ -370,15 +474,161 @@ void tb_sdram_mem::process(void)
 
         sdram_o.DATA_INPUT = resp_data[0];
 
-        // Shuffle read data
+        // Shuffle read data (bus idles low)
         for (int i=1;i<sizeof(resp_data)/sizeof(resp_data[0]);i++)
             resp_data[i-1] = resp_data[i];
+        resp_data[sizeof(resp_data)/sizeof(resp_data[0])-1] = 0;
 
         sdram_out.write(sdram_o);
         wait();
     }
 }
 //-----------------------------------------------------------------
+// reset_stats: Clear command / utilisation counters
+//-----------------------------------------------------------------
+void tb_sdram_mem::reset_stats(void)
+{
+    m_stat_cycles        = 0;
+    m_stat_data_busy     = 0;
+    m_stat_refresh_last  = 0;
+    m_stat_refresh_cnt   = 0;
+    m_stat_refresh_min   = 0;
+    m_stat_refresh_max   = 0;
+    m_stat_refresh_total = 0;
+
+    for (int i=0;i<SDRAM_CMD_MAX;i++)
+        m_stat_cmd[i] = 0;
+
+    for (unsigned b=0;b<MAX_BANKS;b++)
+    {
+        m_stat_row_hit[b]      = 0;
+        m_stat_row_empty[b]    = 0;
+        m_stat_row_conflict[b] = 0;
+        m_row_accessed[b]      = false;
+        m_row_evicted[b]       = false;
+    }
+}
+//-----------------------------------------------------------------
+// print_stats: Command / bus utilisation summary (key=value)
+//-----------------------------------------------------------------
+void tb_sdram_mem::print_stats(void)
+{
+    if (!m_stat_cycles)
+        return;
+
+    const char *tag = m_stats_tag.c_str();
+
+    m_timing[0].print_config();
+
+    printf("%s: cycles=%llu nop=%llu inhibit=%llu active=%llu read=%llu write=%llu precharge=%llu refresh=%llu load_mode=%llu burst_term=%llu\n", tag,
+            (unsigned long long)m_stat_cycles,
+            (unsigned long long)m_stat_cmd[SDRAM_CMD_NOP],
+            (unsigned long long)m_stat_cmd[SDRAM_CMD_INHIBIT],
+            (unsigned long long)m_stat_cmd[SDRAM_CMD_ACTIVE],
+            (unsigned long long)m_stat_cmd[SDRAM_CMD_READ],
+            (unsigned long long)m_stat_cmd[SDRAM_CMD_WRITE],
+            (unsigned long long)m_stat_cmd[SDRAM_CMD_PRECHARGE],
+            (unsigned long long)m_stat_cmd[SDRAM_CMD_REFRESH],
+            (unsigned long long)m_stat_cmd[SDRAM_CMD_LOAD_MODE],
+            (unsigned long long)m_stat_cmd[SDRAM_CMD_BURST_TERM]);
+
+    printf("%s: data_busy=%llu data_util=%.3f\n", tag,
+            (unsigned long long)m_stat_data_busy,
+            (double)m_stat_data_busy / m_stat_cycles);
+
+    for (unsigned b=0;b<m_banks;b++)
+    {
+        if (SDRAM_RANKS > 1)
+            printf("%s: rank=%u ", tag, b >> m_bank_w);
+        else
+            printf("%s: ", tag);
+
+        printf("bank=%u row_hit=%llu row_empty=%llu row_conflict=%llu\n", b & ((1 << m_bank_w) - 1),
+                (unsigned long long)m_stat_row_hit[b],
+                (unsigned long long)m_stat_row_empty[b],
+                (unsigned long long)m_stat_row_conflict[b]);
+    }
+
+    printf("%s: refresh_intervals=%llu interval_min=%llu interval_mean=%.1f interval_max=%llu\n", tag,
+            (unsigned long long)m_stat_refresh_cnt,
+            (unsigned long long)m_stat_refresh_min,
+            m_stat_refresh_cnt ? (double)m_stat_refresh_total / m_stat_refresh_cnt : 0.0,
+            (unsigned long long)m_stat_refresh_max);
+}
+#if VM_SAVABLE
+#define SAVE_MEMBER(m)      os.write(&(m), sizeof(m))
+#define RESTORE_MEMBER(m)   is.read(&(m), sizeof(m))
+
+//-----------------------------------------------------------------
+// save: Mode, bank / refresh state, statistics and contents
+//-----------------------------------------------------------------
+void tb_sdram_mem::save(VerilatedSerialize &os)
+{
+    sc_assert(m_burst_write == 0 && m_burst_read == 0);
+
+    SAVE_MEMBER(m_powered_up);
+    SAVE_MEMBER(m_configured);
+    SAVE_MEMBER(m_burst_type);
+    SAVE_MEMBER(m_burst_length);
+    SAVE_MEMBER(m_write_burst_en);
+    SAVE_MEMBER(m_cas_latency);
+    SAVE_MEMBER(m_active_row);
+    SAVE_MEMBER(m_refresh_cnt);
+    SAVE_MEMBER(m_stat_cycles);
+    SAVE_MEMBER(m_stat_cmd);
+    SAVE_MEMBER(m_stat_data_busy);
+    SAVE_MEMBER(m_stat_row_hit);
+    SAVE_MEMBER(m_stat_row_empty);
+    SAVE_MEMBER(m_stat_row_conflict);
+    SAVE_MEMBER(m_row_accessed);
+    SAVE_MEMBER(m_row_evicted);
+    SAVE_MEMBER(m_stat_refresh_last);
+    SAVE_MEMBER(m_stat_refresh_cnt);
+    SAVE_MEMBER(m_stat_refresh_min);
+    SAVE_MEMBER(m_stat_refresh_max);
+    SAVE_MEMBER(m_stat_refresh_total);
+
+    // Timing state is in cycles (independent of simulation time)
+    for (uint32_t r=0;r<SDRAM_RANKS;r++)
+        m_timing[r].save(os);
+    tb_memory::save(os);
+}
+//-----------------------------------------------------------------
+// restore: Resume from save()
+//-----------------------------------------------------------------
+bool tb_sdram_mem::restore(VerilatedDeserialize &is)
+{
+    RESTORE_MEMBER(m_powered_up);
+    RESTORE_MEMBER(m_configured);
+    RESTORE_MEMBER(m_burst_type);
+    RESTORE_MEMBER(m_burst_length);
+    RESTORE_MEMBER(m_write_burst_en);
+    RESTORE_MEMBER(m_cas_latency);
+    RESTORE_MEMBER(m_active_row);
+    RESTORE_MEMBER(m_refresh_cnt);
+    RESTORE_MEMBER(m_stat_cycles);
+    RESTORE_MEMBER(m_stat_cmd);
+    RESTORE_MEMBER(m_stat_data_busy);
+    RESTORE_MEMBER(m_stat_row_hit);
+    RESTORE_MEMBER(m_stat_row_empty);
+    RESTORE_MEMBER(m_stat_row_conflict);
+    RESTORE_MEMBER(m_row_accessed);
+    RESTORE_MEMBER(m_row_evicted);
+    RESTORE_MEMBER(m_stat_refresh_last);
+    RESTORE_MEMBER(m_stat_refresh_cnt);
+    RESTORE_MEMBER(m_stat_refresh_min);
+    RESTORE_MEMBER(m_stat_refresh_max);
+    RESTORE_MEMBER(m_stat_refresh_total);
+
+    m_burst_write = 0;
+    m_burst_read  = 0;
+
+    for (uint32_t r=0;r<SDRAM_RANKS;r++)
+        m_timing[r].restore(is);
+    return tb_memory::restore(is);
+}
+#endif
+//-----------------------------------------------------------------
 // write32: Write a 32-bit word to memory
 //-----------------------------------------------------------------
 void tb_sdram_mem::write32(uint32_t addr, uint32_t data, uint8_t strb)
@@ -3,9 +3,18 @@
 
 #include "sdram_io.h"
 #include "tb_memory.h"
+#include "sdram_timing_checker.h"
+#include "sdram_profile.h"
+
+#if VM_SAVABLE
+#include "verilated_save.h"
+#endif
 
 //-------------------------------------------------------------
 // tb_sdram_mem: SDRAM testbench memory
+//
+// Models SDRAM_RANKS devices sharing the bus (one CS each).
+// Banks are indexed {rank, bank} as in the RTL address map.
 //-------------------------------------------------------------
 class tb_sdram_mem: public sc_module, public tb_memory
 {
@@ -29,12 +38,19 @@ public:
         m_enable_delays = true;
 
         m_configured = false;
+        m_powered_up = false;
 
-        for (unsigned i=0;i<NUM_BANKS;i++)
+        for (unsigned i=0;i<MAX_BANKS;i++)
             m_active_row[i] = -1;
 
         m_burst_write     = 0;
         m_burst_read      = 0;
+        m_refresh_cnt     = 0;
+        m_board_delay     = 0;
+        m_stats_tag       = "SDRAM";
+
+        set_profile();
+        reset_stats();
     }
 
     //-------------------------------------------------------------
@@ -63,11 +79,63 @@ public:
     void         process(void);
     bool         delay_cycle(void) { return m_enable_delays ? rand() & 1 : 0; }
 
+    // Statistics
+    void         reset_stats(void);
+    void         print_stats(void);
+    void         end_of_simulation(void) { print_stats(); }
+
+    // Multi-channel builds: stats lines tagged SDRAM<ch>
+    void         set_channel(int ch);
+
+    // Geometry + timing rules (NULL = build defaults), false if unknown
+    bool         set_profile(const char *name = NULL);
+    int          col_w(void)  { return m_col_w; }
+    int          row_w(void)  { return m_row_w; }
+    int          bank_w(void) { return m_bank_w; }
+
+    // Extra read data round trip (cycles) for the board / IO path
+    void         set_board_delay(int cycles);
+    int          board_delay(void) { return m_board_delay; }
+
+    // Init sequence (mode + initial refreshes) complete
+    bool         ready(void) { return m_configured && m_refresh_cnt >= 2; }
+
+    // Checkpoint (quiescent points only - no burst in progress)
+#if VM_SAVABLE
+    void         save(VerilatedSerialize &os);
+    bool         restore(VerilatedDeserialize &is);
+#endif
+
 protected:
+    uint32_t     map_addr(uint32_t row, uint32_t bank, uint32_t col);
+    uint32_t     bank_index(uint32_t ranks, uint32_t ba);
+
     bool         m_enable_delays;
-    
+    int          m_col_w;
+    int          m_row_w;
+    int          m_bank_w;      // Per rank
+    uint32_t     m_banks;       // All ranks
+
+    // One set of timing rules per rank
+    static const uint32_t MAX_RANKS = 4;
+    sdram_timing_checker m_timing[MAX_RANKS];
+
+    typedef enum
+    {
+        SDRAM_CMD_INHIBIT = 0,
+        SDRAM_CMD_NOP,
+        SDRAM_CMD_ACTIVE,
+        SDRAM_CMD_READ,
+        SDRAM_CMD_WRITE,
+        SDRAM_CMD_BURST_TERM,
+        SDRAM_CMD_PRECHARGE,
+        SDRAM_CMD_REFRESH,
+        SDRAM_CMD_LOAD_MODE,
+        SDRAM_CMD_MAX
+    } t_sdram_cmd;
 
     bool         m_configured;
+    bool         m_powered_up;
 
     typedef enum eBurstType
     {
@@ -89,18 +157,34 @@ protected:
 
     bool         m_write_burst_en;
     int          m_cas_latency;
+    int          m_board_delay;
 
-    static const uint32_t NUM_BANKS = 4;
-    int          m_active_row[NUM_BANKS];
-    sc_time      m_activate_time[NUM_BANKS];
+    static const int MAX_BOARD_DELAY = 4;
 
-    sc_time      m_last_refresh;
+    static const uint32_t MAX_BANKS = 16;
+    int          m_active_row[MAX_BANKS];
     uint32_t     m_refresh_cnt;
 
     int          m_burst_write;
     int          m_burst_read;
-    bool         m_burst_close_row[NUM_BANKS];
+    bool         m_burst_close_row[MAX_BANKS];
     int          m_burst_offset;
+
+    // Statistics
+    std::string  m_stats_tag;
+    uint64_t     m_stat_cycles;
+    uint64_t     m_stat_cmd[SDRAM_CMD_MAX];
+    uint64_t     m_stat_data_busy;
+    uint64_t     m_stat_row_hit[MAX_BANKS];
+    uint64_t     m_stat_row_empty[MAX_BANKS];
+    uint64_t     m_stat_row_conflict[MAX_BANKS];
+    bool         m_row_accessed[MAX_BANKS];
+    bool         m_row_evicted[MAX_BANKS];
+    uint64_t     m_stat_refresh_last;
+    uint64_t     m_stat_refresh_cnt;
+    uint64_t     m_stat_refresh_min;
+    uint64_t     m_stat_refresh_max;
+    uint64_t     m_stat_refresh_total;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "tb_stream_consumer.h"
+
+//-----------------------------------------------------------------
+// process: Stream frames until stopped
+//-----------------------------------------------------------------
+void tb_stream_consumer::process(void)
+{
+    start_out.write(false);
+    ready_out.write(false);
+    addr_out.write(0);
+    len_out.write(0);
+
+    m_enabled.wait();
+
+    while (!m_stop)
+    {
+        // New frame
+        addr_out.write(m_base);
+        len_out.write(m_words);
+        start_out.write(true);
+        wait();
+        start_out.write(false);
+
+        // Initial fill
+        do
+            wait();
+        while (!valid_in.read());
+
+        for (int i=0;i<m_prefill;i++)
+            wait();
+
+        uint32_t addr = m_base;
+        for (uint32_t w=0;w<m_words;)
+        {
+            // One slot every m_period cycles
+            bool valid = valid_in.read();
+            if (valid)
+            {
+                uint32_t expected = 0;
+                for (int b=0;b<4;b++)
+                    expected |= ((uint32_t)read(addr + b)) << (8 * b);
+
+                uint32_t actual   = data_in.read();
+
+                if (actual != expected)
+                {
+                    if (m_errors < 10)
+                        printf("ERROR: Stream data mismatch @ %08x: %08x != %08x (expected)\n", addr, actual, expected);
+                    m_errors++;
+                }
+
+                addr += 4;
+                w++;
+                m_consumed++;
+            }
+            else
+                m_underruns++;
+
+            ready_out.write(valid);
+            wait();
+            ready_out.write(false);
+
+            for (int p=1;p<m_period;p++)
+                wait();
+        }
+
+        m_frames++;
+
+        // Start the next frame once idle
+        while (busy_in.read())
+            wait();
+    }
+}
+//-----------------------------------------------------------------
+// print_stats: Summary (key=value)
+//-----------------------------------------------------------------
+void tb_stream_consumer::print_stats(void)
+{
+    printf("STREAM: period=%d frames=%llu words=%llu underruns=%llu errors=%llu\n",
+            m_period,
+            (unsigned long long)m_frames,
+            (unsigned long long)m_consumed,
+            (unsigned long long)m_underruns,
+            (unsigned long long)m_errors);
+}
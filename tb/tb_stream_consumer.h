@@ -0,0 +1,88 @@
+#ifndef TB_STREAM_CONSUMER_H
+#define TB_STREAM_CONSUMER_H
+
+#include <systemc.h>
+#include "tb_memory.h"
+
+//-------------------------------------------------------------
+// tb_stream_consumer: Constant rate reader of the streaming port
+//
+// Display-like sink: repeatedly streams a frame and takes one word
+// every 'period' cycles. A word not available on its cycle is an
+// underrun (it is taken on a later slot, the frame does not slip).
+// Data is checked against the shadow copy (tb_memory).
+//-------------------------------------------------------------
+class tb_stream_consumer: public sc_module, public tb_memory
+{
+public:
+    //-------------------------------------------------------------
+    // Interface I/O
+    //-------------------------------------------------------------
+    sc_in <bool>             clk_in;
+    sc_in <bool>             rst_in;
+
+    sc_out <bool>            start_out;
+    sc_out <sc_uint<32> >    addr_out;
+    sc_out <sc_uint<32> >    len_out;
+    sc_out <bool>            ready_out;
+    sc_in  <bool>            valid_in;
+    sc_in  <sc_uint<32> >    data_in;
+    sc_in  <bool>            busy_in;
+
+    //-------------------------------------------------------------
+    // Constructor
+    //-------------------------------------------------------------
+    SC_HAS_PROCESS(tb_stream_consumer);
+    tb_stream_consumer(sc_module_name name): sc_module(name)
+                                           , m_enabled("enabled", 0)
+    { 
+        SC_CTHREAD(process, clk_in.pos());
+        m_base      = 0;
+        m_words     = 0;
+        m_period    = 4;
+        m_prefill   = 0;
+        m_stop      = false;
+        m_frames    = 0;
+        m_consumed  = 0;
+        m_underruns = 0;
+        m_errors    = 0;
+    }
+
+    //-------------------------------------------------------------
+    // API
+    //-------------------------------------------------------------
+    // Frame of 'words' 32-bit words from base, one word per 'period' cycles.
+    // Consumption starts 'prefill' cycles after the first word arrives.
+    void     configure(uint32_t base, uint32_t words, int period, int prefill = 0)
+    {
+        m_base    = base;
+        m_words   = words;
+        m_period  = period;
+        m_prefill = prefill;
+    }
+
+    void     start(void) { m_stop = false; m_enabled.post(); }
+    void     stop(void)  { m_stop = true; }
+
+    uint64_t underruns(void) { return m_underruns; }
+    uint64_t errors(void)    { return m_errors; }
+    void     print_stats(void);
+
+    void     process(void);
+
+protected:
+    sc_semaphore m_enabled;
+    uint32_t     m_base;
+    uint32_t     m_words;
+    int          m_period;
+    int          m_prefill;
+    bool         m_stop;
+
+    // Statistics
+    uint64_t     m_frames;
+    uint64_t     m_consumed;
+    uint64_t     m_underruns;
+    uint64_t     m_errors;
+};
+
+#endif
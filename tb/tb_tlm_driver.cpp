@@ -0,0 +1,70 @@
+#include "tb_tlm_driver.h"
+
+//-----------------------------------------------------------------
+// transport: Issue a single generic payload
+//-----------------------------------------------------------------
+void tb_tlm_driver::transport(bool write, uint32_t addr, uint8_t *data, int length)
+{
+    tlm::tlm_generic_payload trans;
+    sc_time delay = m_offset;
+
+    trans.set_command(write ? tlm::TLM_WRITE_COMMAND : tlm::TLM_READ_COMMAND);
+    trans.set_address(addr);
+    trans.set_data_ptr(data);
+    trans.set_data_length(length);
+    trans.set_streaming_width(length);
+    trans.set_byte_enable_ptr(NULL);
+    trans.set_dmi_allowed(false);
+    trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+
+    isock->b_transport(trans, delay);
+
+    if (trans.is_response_error())
+    {
+        printf("ERROR: TLM %s failed 0x%08x (%s)\n", write ? "write" : "read", addr,
+                trans.get_response_string().c_str());
+        sc_assert(0);
+    }
+
+    m_offset = delay;
+}
+//-----------------------------------------------------------------
+// write32: Write a 32-bit word
+//-----------------------------------------------------------------
+void tb_tlm_driver::write32(uint32_t addr, uint32_t data)
+{
+    uint8_t buffer[4];
+    for (int i=0;i<4;i++)
+        buffer[i] = data >> (i * 8);
+
+    transport(true, addr, buffer, 4);
+}
+//-----------------------------------------------------------------
+// read32: Read a 32-bit word
+//-----------------------------------------------------------------
+uint32_t tb_tlm_driver::read32(uint32_t addr)
+{
+    uint8_t  buffer[4];
+    uint32_t data = 0;
+
+    transport(false, addr, buffer, 4);
+
+    for (int i=0;i<4;i++)
+        data |= ((uint32_t)buffer[i]) << (i * 8);
+
+    return data;
+}
+//-----------------------------------------------------------------
+// write: Write a block
+//-----------------------------------------------------------------
+void tb_tlm_driver::write(uint32_t addr, uint8_t *data, int length)
+{
+    transport(true, addr, data, length);
+}
+//-----------------------------------------------------------------
+// read: Read a block
+//-----------------------------------------------------------------
+void tb_tlm_driver::read(uint32_t addr, uint8_t *data, int length)
+{
+    transport(false, addr, data, length);
+}
@@ -0,0 +1,56 @@
+#ifndef TB_TLM_DRIVER_H
+#define TB_TLM_DRIVER_H
+
+#include <systemc.h>
+#include <tlm.h>
+#include <tlm_utils/simple_initiator_socket.h>
+#include "tb_driver_api.h"
+
+//-------------------------------------------------------------
+// tb_tlm_driver: TLM-2.0 initiator (LT, temporally decoupled)
+//
+// Never yields to the kernel; time advances in a local offset
+// which is carried from one b_transport to the next.
+//-------------------------------------------------------------
+class tb_tlm_driver: public sc_module, public tb_driver_api
+{
+public:
+    //-------------------------------------------------------------
+    // Interface I/O
+    //-------------------------------------------------------------
+    tlm_utils::simple_initiator_socket<tb_tlm_driver> isock;
+
+    //-------------------------------------------------------------
+    // Constructor
+    //-------------------------------------------------------------
+    tb_tlm_driver(sc_module_name name): sc_module(name), isock("isock")
+    {
+        m_offset = SC_ZERO_TIME;
+    }
+
+    //-------------------------------------------------------------
+    // API
+    //-------------------------------------------------------------
+    void         write32(uint32_t addr, uint32_t data);
+    uint32_t     read32(uint32_t addr);
+    void         write(uint32_t addr, uint8_t *data, int length);
+    void         read(uint32_t addr, uint8_t *data, int length);
+
+    sc_time      local_time(void) { return sc_time_stamp() + m_offset; }
+
+    // Move local time forward to t (t >= sim time)
+    void         set_local_time(sc_time t)
+    {
+        sc_assert(t >= sc_time_stamp());
+        m_offset = t - sc_time_stamp();
+    }
+
+    // Internal
+protected:
+    void         transport(bool write, uint32_t addr, uint8_t *data, int length);
+
+protected:
+    sc_time      m_offset;
+};
+
+#endif
@@ -0,0 +1,177 @@
+#include "tb_trace_replay.h"
+#include <string.h>
+
+//-----------------------------------------------------------------
+// open: Open trace file
+//-----------------------------------------------------------------
+bool tb_trace_replay::open(std::string filename)
+{
+    m_file = fopen(filename.c_str(), "r");
+    if (!m_file)
+    {
+        printf("ERROR: Cannot open trace file %s\n", filename.c_str());
+        return false;
+    }
+
+    m_filename = filename;
+    return true;
+}
+//-----------------------------------------------------------------
+// parse_line: Decode a trace entry (returns false for blank/comments)
+//-----------------------------------------------------------------
+bool tb_trace_replay::parse_line(char *line, bool &write, uint32_t &addr, int &len, int &burst, int &id, int &delay)
+{
+    char dir[8];
+    char type[8];
+    long     a;
+
+    // Strip comments
+    char *p = strchr(line, '#');
+    if (p)
+        *p = 0;
+
+    if (sscanf(line, "%7s %li %i %7s %i %i", dir, &a, &len, type, &id, &delay) != 6)
+        return false;
+
+    write = (dir[0] == 'W' || dir[0] == 'w');
+    addr  = (uint32_t)a;
+
+    if (!strcasecmp(type, "FIXED"))
+        burst = AXI4_BURST_FIXED;
+    else if (!strcasecmp(type, "INCR"))
+        burst = AXI4_BURST_INCR;
+    else if (!strcasecmp(type, "WRAP"))
+        burst = AXI4_BURST_WRAP;
+    else
+        burst = strtol(type, NULL, 0);
+
+    sc_assert(len >= 0 && len <= 255);
+    sc_assert(burst != AXI4_BURST_WRAP || len == 1 || len == 3 || len == 7 || len == 15);
+
+    return true;
+}
+//-----------------------------------------------------------------
+// fold_address: Map a trace address into the local memory region
+//-----------------------------------------------------------------
+uint32_t tb_trace_replay::fold_address(uint32_t addr, uint32_t bytes)
+{
+    uint32_t base = m_mem[0]->get_base();
+    uint32_t size = m_mem[0]->get_size();
+
+    uint32_t offset = (addr % size) & ~3;
+
+    // Burst would run off the end of the region - start of region instead
+    if ((offset + bytes) > size)
+        offset = 0;
+
+    return base + offset;
+}
+//-----------------------------------------------------------------
+// beat_address: Address of a beat within a burst
+//-----------------------------------------------------------------
+uint32_t tb_trace_replay::beat_address(uint32_t addr, int beat, int len, int burst)
+{
+    switch (burst)
+    {
+        case AXI4_BURST_FIXED:
+            return addr;
+        case AXI4_BURST_WRAP:
+        {
+            uint32_t span = (len + 1) * 4;
+            return (addr & ~(span - 1)) | ((addr + (beat * 4)) & (span - 1));
+        }
+        default:
+            return addr + (beat * 4);
+    }
+}
+//-----------------------------------------------------------------
+// process: Stream trace file through the driver
+//-----------------------------------------------------------------
+void tb_trace_replay::process(void)
+{
+    uint8_t buffer[256 * 4];
+    char    line[256];
+
+    while (true)
+    {
+        m_enabled.wait();
+        printf("Starting trace replay %s (%s)...\n", m_filename.c_str(), m_timed ? "timed" : "fast");
+
+        sc_assert(m_file);
+
+        sc_clock *clk = dynamic_cast<sc_clock *>(clk_in.get_interface());
+        if (clk)
+            m_stats.set_period(clk->period());
+
+        m_stats.start();
+        sc_time last_issue = sc_time_stamp();
+
+        while (fgets(line, sizeof(line), m_file))
+        {
+            bool     write;
+            uint32_t addr;
+            int      len;
+            int      burst;
+            int      id;
+            int      delay;
+
+            if (!parse_line(line, write, addr, len, burst, id, delay))
+                continue;
+
+            // Honour recorded inter-arrival time (from the previous issue,
+            // which has already completed - see tb_trace_replay.h)
+            if (m_timed)
+            {
+                int elapsed = (int)((sc_time_stamp() - last_issue) / m_stats.period());
+                if (elapsed < delay)
+                    wait(delay - elapsed);
+                else if (elapsed > delay)
+                    m_stats.record_late();
+            }
+
+            uint32_t bytes = (burst == AXI4_BURST_FIXED) ? 4 : (len + 1) * 4;
+            addr = fold_address(addr, bytes);
+
+            last_issue = sc_time_stamp();
+
+            if (write)
+            {
+                for (int i=0;i<=len;i++)
+                    for (int x=0;x<4;x++)
+                    {
+                        buffer[(i*4)+x] = rand();
+                        this->write(beat_address(addr, i, len, burst) + x, buffer[(i*4)+x]);
+                    }
+
+                m_driver->write_burst(addr, buffer, len, burst, id);
+            }
+            else
+            {
+                m_driver->read_burst(addr, buffer, len, burst, id);
+
+                for (int i=0;i<=len;i++)
+                {
+                    uint32_t beat_addr = beat_address(addr, i, len, burst);
+                    for (int x=0;x<4;x++)
+                    {
+                        if (this->read(beat_addr + x) != buffer[(i*4)+x])
+                            printf("MISMATCH: %08x -> %02x != %02x\n", beat_addr + x, buffer[(i*4)+x], this->read(beat_addr + x));
+                        sc_assert(this->read(beat_addr + x) == buffer[(i*4)+x]);
+                    }
+                }
+            }
+
+            m_stats.record(write, (len + 1) * 4, len + 1, last_issue);
+        }
+
+        m_stats.stop();
+        m_stats.report();
+
+        fclose(m_file);
+        m_file = NULL;
+
+        // Notify completion
+        printf("Completed trace replay...\n");
+        m_completed.post();
+    }
+}
@@ -0,0 +1,123 @@
+#include "tb_xcheck_driver.h"
+#include <math.h>
+
+//-----------------------------------------------------------------
+// reset_stats
+//-----------------------------------------------------------------
+void tb_xcheck_driver::reset_stats(void)
+{
+    m_txns         = 0;
+    m_rtl_total    = 0;
+    m_tlm_total    = 0;
+    m_err_total    = 0;
+    m_err_max      = 0;
+    m_within_10pct = 0;
+}
+//-----------------------------------------------------------------
+// compare: Accumulate latency error (TLM - RTL) in cycles
+//-----------------------------------------------------------------
+void tb_xcheck_driver::compare(sc_time t_issue, sc_time t_tlm_done)
+{
+    double rtl = (sc_time_stamp() - t_issue) / m_period;
+    double tlm = (t_tlm_done - t_issue) / m_period;
+    double err = fabs(tlm - rtl);
+
+    m_txns      += 1;
+    m_rtl_total += rtl;
+    m_tlm_total += tlm;
+    m_err_total += err;
+
+    if (err > m_err_max)
+        m_err_max = err;
+
+    if (err <= (rtl * 0.1))
+        m_within_10pct += 1;
+}
+//-----------------------------------------------------------------
+// write32: Write a 32-bit word
+//-----------------------------------------------------------------
+void tb_xcheck_driver::write32(uint32_t addr, uint32_t data)
+{
+    sc_time t_issue = sc_time_stamp();
+
+    m_tlm->set_local_time(t_issue);
+    m_tlm->write32(addr, data);
+    m_rtl->write32(addr, data);
+
+    compare(t_issue, m_tlm->local_time());
+}
+//-----------------------------------------------------------------
+// read32: Read a 32-bit word
+//-----------------------------------------------------------------
+uint32_t tb_xcheck_driver::read32(uint32_t addr)
+{
+    sc_time t_issue = sc_time_stamp();
+
+    m_tlm->set_local_time(t_issue);
+    uint32_t tlm_data = m_tlm->read32(addr);
+    uint32_t rtl_data = m_rtl->read32(addr);
+
+    compare(t_issue, m_tlm->local_time());
+
+    if (tlm_data != rtl_data)
+    {
+        printf("ERROR: XCHECK %08x RTL=%08x TLM=%08x\n", addr, rtl_data, tlm_data);
+        sc_assert(0);
+    }
+
+    return rtl_data;
+}
+//-----------------------------------------------------------------
+// write: Write a block
+//-----------------------------------------------------------------
+void tb_xcheck_driver::write(uint32_t addr, uint8_t *data, int length)
+{
+    sc_time t_issue = sc_time_stamp();
+
+    m_tlm->set_local_time(t_issue);
+    m_tlm->write(addr, data, length);
+    m_rtl->write(addr, data, length);
+
+    compare(t_issue, m_tlm->local_time());
+}
+//-----------------------------------------------------------------
+// read: Read a block
+//-----------------------------------------------------------------
+void tb_xcheck_driver::read(uint32_t addr, uint8_t *data, int length)
+{
+    sc_time  t_issue  = sc_time_stamp();
+    uint8_t *tlm_data = new uint8_t[length];
+
+    m_tlm->set_local_time(t_issue);
+    m_tlm->read(addr, tlm_data, length);
+    m_rtl->read(addr, data, length);
+
+    compare(t_issue, m_tlm->local_time());
+
+    for (int i=0;i<length;i++)
+    {
+        if (tlm_data[i] != data[i])
+        {
+            printf("ERROR: XCHECK %08x RTL=%02x TLM=%02x\n", addr + i, data[i], tlm_data[i]);
+            sc_assert(0);
+        }
+    }
+
+    delete [] tlm_data;
+}
+//-----------------------------------------------------------------
+// report: Latency agreement summary (bias = mean TLM - RTL cycles)
+//-----------------------------------------------------------------
+void tb_xcheck_driver::report(void)
+{
+    double n = m_txns ? (double)m_txns : 1.0;
+
+    printf("XCHECK: txns=%llu rtl_lat_mean=%.2f tlm_lat_mean=%.2f bias=%.2f abs_err_mean=%.2f abs_err_max=%.0f within_10pct=%.3f\n",
+            (unsigned long long)m_txns,
+            m_rtl_total / n,
+            m_tlm_total / n,
+            (m_tlm_total - m_rtl_total) / n,
+            m_err_total / n,
+            m_err_max,
+            m_within_10pct / n);
+}
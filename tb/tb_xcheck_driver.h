@@ -0,0 +1,50 @@
+#ifndef TB_XCHECK_DRIVER_H
+#define TB_XCHECK_DRIVER_H
+
+#include <systemc.h>
+#include "tb_driver_api.h"
+#include "tb_tlm_driver.h"
+
+//-------------------------------------------------------------
+// tb_xcheck_driver: Run each access on the RTL and TLM model,
+//                   compare read data and latency
+//-------------------------------------------------------------
+class tb_xcheck_driver: public tb_driver_api
+{
+public:
+    tb_xcheck_driver(tb_driver_api *rtl, tb_tlm_driver *tlm)
+    {
+        m_rtl    = rtl;
+        m_tlm    = tlm;
+        m_period = sc_time(1, SC_NS);
+        reset_stats();
+    }
+
+    void         set_period(sc_time period) { m_period = period; }
+
+    void         write32(uint32_t addr, uint32_t data);
+    uint32_t     read32(uint32_t addr);
+    void         write(uint32_t addr, uint8_t *data, int length);
+    void         read(uint32_t addr, uint8_t *data, int length);
+
+    void         reset_stats(void);
+    void         report(void);
+
+    // Internal
+protected:
+    void         compare(sc_time t_issue, sc_time t_tlm_done);
+
+protected:
+    tb_driver_api * m_rtl;
+    tb_tlm_driver * m_tlm;
+    sc_time         m_period;
+
+    uint64_t        m_txns;
+    double          m_rtl_total;
+    double          m_tlm_total;
+    double          m_err_total;
+    double          m_err_max;
+    uint64_t        m_within_10pct;
+};
+
+#endif
@@ -1,64 +1,526 @@
 #include <systemc.h>
 #include "testbench_vbase.h"
+#include "sdram_config.h"
 
 #include "tb_memory.h"
 #include "tb_axi4_driver.h"
 #include "tb_sdram_mem.h"
 #include "tb_mem_test.h"
+#include "tb_trace_replay.h"
+#include "tb_mem_bench.h"
+#include "tb_tlm_driver.h"
+#include "tb_xcheck_driver.h"
+#include "tb_stream_consumer.h"
+#include "tb_xfer_bench.h"
 
 #include "sdram_axi.h"
+#include "sdram_axi_tlm.h"
+
+#if VM_SAVABLE
+#include "verilated_save.h"
+#endif
+
+// Dual clock build: SDRAM clock domain on the main.cpp CLK1 hooks
+#ifdef SDRAM_AXI_ASYNC
+    #define CLK1_NAME           clk_sdram
+    #define RST1_NAME           rst_sdram
+#endif
+
+// Two channel build (sdram_axi_dual): single clock only
+#ifdef SDRAM_AXI_DUAL
+    #ifdef SDRAM_AXI_ASYNC
+        #error "SDRAM_AXI_DUAL does not support SDRAM_AXI_ASYNC"
+    #endif
+    #ifndef SDRAM_INTERLEAVE_W
+        #define SDRAM_INTERLEAVE_W  5
+    #endif
+#endif
+
+#if defined(SDRAM_AXI_DUAL) && (defined(SDRAM_AXI_STREAM) || defined(SDRAM_AXI_XFER))
+    #error "SDRAM_AXI_STREAM / SDRAM_AXI_XFER are not available on sdram_axi_dual"
+#endif
 
 #define MEM_BASE 0x00000000
 #define MEM_SIZE (512 * 1024)
 
+// Streaming read port frame (SDRAM_AXI_STREAM), not touched over AXI
+#define STREAM_BASE (MEM_BASE + MEM_SIZE)
+#define STREAM_SIZE (64 * 1024)
+
+// Fill / copy benchmark (SDRAM_AXI_XFER): two halves of this, in the test region
+#define XFER_SIZE   (128 * 1024)
+
+// SDRAM_READ_CAL=1 build: calibration word (last word of the SDRAM)
+#define SDRAM_CAL_ADDR          ((2u << (SDRAM_ADDR_W + SDRAM_RANK_W)) - 4)
+#if defined(CLK1_NAME) && !defined(CLK1_PERIOD)
+    #define CLK1_PERIOD         (1000 / SDRAM_MHZ)
+#endif
+
 //-----------------------------------------------------------------
 // Module
 //-----------------------------------------------------------------
 class testbench: public testbench_vbase
 {
 public:
+#ifdef SDRAM_AXI_ASYNC
+    sc_in <bool>              clk_sdram;
+    sc_in <bool>              rst_sdram;
+#endif
+
     tb_axi4_driver           *m_driver;
     tb_mem_test              *m_sequencer;
+    tb_trace_replay          *m_replay;
+    tb_mem_bench             *m_bench;
     sdram_axi                *m_dut;
     tb_sdram_mem             *m_mem;
+#ifdef SDRAM_AXI_DUAL
+    tb_sdram_mem             *m_mem1;
+#endif
+    tb_tlm_driver            *m_tlm_driver;
+    tb_xcheck_driver         *m_xcheck;
+    sdram_axi_tlm            *m_tlm;
+#ifdef SDRAM_AXI_STREAM
+    tb_stream_consumer       *m_stream;
+
+    sc_signal <bool>           stream_start;
+    sc_signal <sc_uint<32> >   stream_addr;
+    sc_signal <sc_uint<32> >   stream_len;
+    sc_signal <bool>           stream_ready;
+    sc_signal <bool>           stream_valid;
+    sc_signal <sc_uint<32> >   stream_data;
+    sc_signal <bool>           stream_busy;
+#endif
+#ifdef SDRAM_AXI_XFER
+    tb_xfer_bench            *m_xfer;
+
+    sc_signal <bool>           xfer_start;
+    sc_signal <bool>           xfer_copy;
+    sc_signal <sc_uint<32> >   xfer_src;
+    sc_signal <sc_uint<32> >   xfer_dst;
+    sc_signal <sc_uint<32> >   xfer_len;
+    sc_signal <sc_uint<32> >   xfer_fill_data;
+    sc_signal <bool>           xfer_busy;
+    sc_signal <bool>           xfer_done;
+#endif
 
     sc_signal <axi4_master>    axi_m;
     sc_signal <axi4_slave>     axi_s;
 
     sc_signal <sdram_io_master>    sdram_io_m;
     sc_signal <sdram_io_slave>     sdram_io_s;
+#ifdef SDRAM_AXI_DUAL
+    sc_signal <sdram_io_master>    sdram1_io_m;
+    sc_signal <sdram_io_slave>     sdram1_io_s;
+#endif
+
+    std::string               m_replay_file;
+    bool                      m_replay_timed;
+    std::string               m_bench_name;
+    int                       m_bench_ops;
+    int                       m_iterations;
+    bool                      m_tlm_only;
+    bool                      m_tlm_xcheck;
+    std::string               m_checkpoint_save;
+    std::string               m_checkpoint_restore;
+    std::string               m_profile;
+    int                       m_rready_throttle;
+    bool                      m_wdata_first;
+    int                       m_board_delay;
+    int                       m_stream_period;
+    bool                      m_xfer_bench;
+
+    void set_iterations(int iterations) { m_iterations = iterations; }
+
+    //-----------------------------------------------------------------
+    // mem_write: Backdoor write to the SDRAM model holding addr
+    //-----------------------------------------------------------------
+    void mem_write(uint32_t addr, uint8_t data)
+    {
+#ifdef SDRAM_AXI_DUAL
+        // Channel bit is removed from the device address (as the RTL)
+        uint32_t local = ((addr >> (SDRAM_INTERLEAVE_W + 1)) << SDRAM_INTERLEAVE_W) |
+                         (addr & ((1u << SDRAM_INTERLEAVE_W) - 1));
+
+        if ((addr >> SDRAM_INTERLEAVE_W) & 1)
+            m_mem1->write(local, data);
+        else
+            m_mem->write(local, data);
+#else
+        m_mem->write(addr, data);
+#endif
+    }
+    //-----------------------------------------------------------------
+    // mem_ready: All SDRAM models initialised
+    //-----------------------------------------------------------------
+    bool mem_ready(void)
+    {
+#ifdef SDRAM_AXI_DUAL
+        if (!m_mem1->ready())
+            return false;
+#endif
+        return m_mem->ready();
+    }
+
+    //-----------------------------------------------------------------
+    // set_argcv: Testbench specific options
+    //-----------------------------------------------------------------
+    void set_argcv(int argc, char* argv[])
+    {
+        for (int i=1;i<argc;i++)
+        {
+            if (!strcmp(argv[i], "--replay") && (i+1) < argc)
+                m_replay_file = argv[++i];
+            else if (!strcmp(argv[i], "--replay-timed") && (i+1) < argc)
+                m_replay_timed = strtol(argv[++i], NULL, 0);
+            else if (!strcmp(argv[i], "--bench") && (i+1) < argc)
+                m_bench_name = argv[++i];
+            else if (!strcmp(argv[i], "--bench-ops") && (i+1) < argc)
+                m_bench_ops = strtol(argv[++i], NULL, 0);
+            else if (!strcmp(argv[i], "--tlm"))
+                m_tlm_only = true;
+            else if (!strcmp(argv[i], "--tlm-xcheck"))
+                m_tlm_xcheck = true;
+            else if (!strcmp(argv[i], "--checkpoint-save") && (i+1) < argc)
+                m_checkpoint_save = argv[++i];
+            else if (!strcmp(argv[i], "--checkpoint-restore") && (i+1) < argc)
+                m_checkpoint_restore = argv[++i];
+            else if (!strcmp(argv[i], "--sdram-profile") && (i+1) < argc)
+                m_profile = argv[++i];
+            else if (!strcmp(argv[i], "--rready-throttle") && (i+1) < argc)
+                m_rready_throttle = strtol(argv[++i], NULL, 0);
+            else if (!strcmp(argv[i], "--wdata-first"))
+                m_wdata_first = true;
+            else if (!strcmp(argv[i], "--board-delay") && (i+1) < argc)
+                m_board_delay = strtol(argv[++i], NULL, 0);
+            else if (!strcmp(argv[i], "--stream-period") && (i+1) < argc)
+                m_stream_period = strtol(argv[++i], NULL, 0);
+            else if (!strcmp(argv[i], "--xfer-bench"))
+                m_xfer_bench = true;
+        }
+
+#ifndef SDRAM_AXI_STREAM
+        if (m_stream_period)
+        {
+            printf("ERROR: --stream-period requires a STREAM=1 build\n");
+            exit(1);
+        }
+#endif
+#ifndef SDRAM_AXI_XFER
+        if (m_xfer_bench)
+        {
+            printf("ERROR: --xfer-bench requires an XFER=1 build\n");
+            exit(1);
+        }
+#endif
+
+        if (m_board_delay)
+        {
+            m_mem->set_board_delay(m_board_delay);
+#ifdef SDRAM_AXI_DUAL
+            m_mem1->set_board_delay(m_board_delay);
+#endif
+        }
+
+        // Profile geometry must match the RTL build (make PROFILE=...)
+        if (m_profile != "")
+        {
+            if (!m_mem->set_profile(m_profile.c_str()))
+                exit(1);
+#ifdef SDRAM_AXI_DUAL
+            m_mem1->set_profile(m_profile.c_str());
+#endif
+
+            if (m_mem->col_w() != SDRAM_COL_W || m_mem->bank_w() != SDRAM_BANK_W ||
+                (m_mem->row_w() + m_mem->col_w() + m_mem->bank_w()) != SDRAM_ADDR_W)
+            {
+                printf("ERROR: SDRAM profile %s geometry differs from the RTL build (SDRAM_ADDR_W=%d, SDRAM_COL_W=%d, SDRAM_BANK_W=%d)\n",
+                        m_profile.c_str(), SDRAM_ADDR_W, SDRAM_COL_W, SDRAM_BANK_W);
+                exit(1);
+            }
+        }
+
+#if !VM_SAVABLE
+        if (m_checkpoint_save != "" || m_checkpoint_restore != "")
+        {
+            printf("ERROR: Checkpoints require a SAVABLE=1 build\n");
+            exit(1);
+        }
+#endif
+
+        if (m_bench_name != "" && !tb_mem_bench::valid_name(m_bench_name))
+        {
+            printf("ERROR: Unknown benchmark %s\n", m_bench_name.c_str());
+            exit(1);
+        }
+    }
+
+#if VM_SAVABLE
+    //-----------------------------------------------------------------
+    // save_checkpoint: RTL, SDRAM model, shadow memories and RNG
+    //-----------------------------------------------------------------
+    void save_checkpoint(std::string filename)
+    {
+        VerilatedSave os;
+        os.open(filename.c_str());
+        if (!os.isOpen())
+        {
+            printf("ERROR: Cannot write checkpoint %s\n", filename.c_str());
+            exit(1);
+        }
+
+        // rand() state is opaque: reseed both this run and restored runs
+        uint32_t seed = rand();
+        os.write(&seed, sizeof(seed));
+        srand(seed);
+
+        m_dut->save(os);
+        m_mem->save(os);
+#ifdef SDRAM_AXI_DUAL
+        m_mem1->save(os);
+#endif
+        m_sequencer->save(os);
+        m_replay->save(os);
+        m_bench->save(os);
+        m_tlm->save(os);
+        os.close();
+
+        cout << "CHECKPOINT: Saved " << filename << " @ " << sc_time_stamp() << endl;
+    }
+    //-----------------------------------------------------------------
+    // restore_checkpoint: Resume from save_checkpoint()
+    //-----------------------------------------------------------------
+    void restore_checkpoint(std::string filename)
+    {
+        VerilatedRestore is;
+        is.open(filename.c_str());
+        if (!is.isOpen())
+        {
+            printf("ERROR: Cannot read checkpoint %s\n", filename.c_str());
+            exit(1);
+        }
+
+        uint32_t seed;
+        is.read(&seed, sizeof(seed));
+        srand(seed);
+
+        m_dut->restore(is);
+        bool ok = m_mem->restore(is);
+#ifdef SDRAM_AXI_DUAL
+        ok &= m_mem1->restore(is);
+#endif
+        ok &= m_sequencer->restore(is);
+        ok &= m_replay->restore(is);
+        ok &= m_bench->restore(is);
+        ok &= m_tlm->restore(is);
+        is.close();
+
+        if (!ok)
+        {
+            printf("ERROR: Checkpoint %s memory layout mismatch\n", filename.c_str());
+            exit(1);
+        }
+
+        printf("CHECKPOINT: Restored %s\n", filename.c_str());
+    }
+#endif
+
+    //-----------------------------------------------------------------
+    // monitor: Address triggered waves (WAVES_ADDR)
+    //-----------------------------------------------------------------
+    void monitor(void)
+    {
+        if (!waves_triggered())
+            return;
+
+        while (1)
+        {
+            axi4_master m = axi_m.read();
+            if (m.ARVALID)
+                waves_address(m.ARADDR);
+            if (m.AWVALID)
+                waves_address(m.AWADDR);
+            wait();
+        }
+    }
 
     //-----------------------------------------------------------------
     // process: Drive input sequence
     //-----------------------------------------------------------------
-    void process(void) 
+    void process(void)
     {
         wait();
 
+        speed_start();
+
         m_driver->enable_delays(true);
+        m_driver->set_rready_throttle(m_rready_throttle);
+        m_driver->set_wdata_first(m_wdata_first);
+
+        // TLM model runs on the testbench clock (cycle 0 = reset release)
+        sc_clock *c = dynamic_cast<sc_clock *>(clk.get_interface());
+        if (c)
+        {
+            m_tlm->set_period(c->period());
+            m_tlm->set_origin(c->period());
+            m_xcheck->set_period(c->period());
+        }
+
+        // Route sequencers to the TLM model (alone, or alongside the RTL)
+        if (m_tlm_only || m_tlm_xcheck)
+        {
+            tb_driver_api *drv = m_tlm_only ? (tb_driver_api *)m_tlm_driver : (tb_driver_api *)m_xcheck;
+            m_sequencer->set_driver(drv);
+            m_bench->set_driver(drv);
+
+            // Latency comparison needs a deterministic RTL driver
+            if (m_tlm_xcheck)
+                m_driver->enable_delays(false);
+        }
 
         // Allocate some memory
         m_mem->add_region(MEM_BASE, MEM_SIZE);
+        m_tlm->add_region(MEM_BASE, MEM_SIZE);
+#ifdef SDRAM_AXI_DUAL
+        m_mem1->add_region(MEM_BASE, MEM_SIZE);
+#endif
+
+        // Written by the RTL read latency calibration after init
+        if (SDRAM_READ_CAL)
+        {
+            m_mem->add_region(SDRAM_CAL_ADDR, 4);
+#ifdef SDRAM_AXI_DUAL
+            m_mem1->add_region(SDRAM_CAL_ADDR, 4);
+#endif
+        }
+
+#ifdef SDRAM_AXI_STREAM
+        m_mem->add_region(STREAM_BASE, STREAM_SIZE);
+        m_stream->add_region(STREAM_BASE, STREAM_SIZE);
+
+        for (int i=0;i<STREAM_SIZE;i++)
+            m_stream->write(STREAM_BASE + i, (uint8_t)(i ^ (i >> 8)));
+#endif
 
         // Allocate some memory
         m_sequencer->add_region(MEM_BASE, MEM_SIZE);
         m_sequencer->trace_access(true);
+        m_replay->add_region(MEM_BASE, MEM_SIZE);
+        m_bench->add_region(MEM_BASE, MEM_SIZE);
+
+#if VM_SAVABLE
+        // Resume from a warmed-up point (SDRAM initialised, memories loaded)
+        if (m_checkpoint_restore != "")
+            restore_checkpoint(m_checkpoint_restore);
+        else
+#endif
+        {
+            // Initialise to memory known value
+            for (int i=0;i<MEM_SIZE;i++)
+            {
+                 m_sequencer->write(MEM_BASE + i, i);
+                 m_replay->write(MEM_BASE + i, i);
+                 m_bench->write(MEM_BASE + i, i);
+                 mem_write(MEM_BASE + i, i);
+                 m_tlm->write(MEM_BASE + i, i);
+            }
+
+#ifdef SDRAM_AXI_STREAM
+            for (int i=0;i<STREAM_SIZE;i++)
+                mem_write(STREAM_BASE + i, (uint8_t)(i ^ (i >> 8)));
+#endif
+        }
+
+#if VM_SAVABLE
+        // Warm point: SDRAM init sequence complete, no traffic yet
+        if (m_checkpoint_save != "")
+        {
+            while (!mem_ready())
+                wait();
+
+            save_checkpoint(m_checkpoint_save);
+        }
+#endif
+
+#ifdef SDRAM_AXI_STREAM
+        // Constant rate display-like reader alongside the AXI workload
+        if (m_stream_period)
+        {
+            m_stream->configure(STREAM_BASE, STREAM_SIZE / 4, m_stream_period);
+            m_stream->start();
+        }
+#endif
+
+        // Replay recorded workload
+        if (m_replay_file != "")
+        {
+            // Measure the controller, not random driver stalls
+            m_driver->enable_delays(false);
+
+            sc_assert(m_replay->open(m_replay_file));
+            m_replay->set_timed(m_replay_timed);
+            m_replay->start();
+            m_replay->wait_complete();
+        }
+#ifdef SDRAM_AXI_XFER
+        // Fill / copy over AXI vs. the RTL engine
+        else if (m_xfer_bench)
+        {
+            m_driver->enable_delays(false);
+
+            m_xfer->start(MEM_BASE, XFER_SIZE);
+            m_xfer->wait_complete();
+        }
+#endif
+        // Standard access pattern benchmarks
+        else if (m_bench_name != "")
+        {
+            m_driver->enable_delays(false);
+
+            m_bench->start(m_bench_name, m_bench_ops);
+            m_bench->wait_complete();
+        }
+        else
+        {
+            m_sequencer->start(m_iterations);
+            m_sequencer->wait_complete();
+        }
 
-        // Initialise to memory known value
-        for (int i=0;i<MEM_SIZE;i++)
+        if (m_tlm_xcheck)
+            m_xcheck->report();
+
+#ifdef SDRAM_AXI_STREAM
+        if (m_stream_period)
         {
-             m_sequencer->write(MEM_BASE + i, i);
-             m_mem->write(MEM_BASE + i, i);
+            m_stream->stop();
+            m_stream->print_stats();
         }
+#endif
+
+        // Cross-ID out of order read completions (AXI_READ_REORDER=1),
+        // reported with the benchmark / replay stats, or when the random
+        // test saw any (never in an in-order build)
+        if (!m_tlm_only && (m_bench_name != "" || m_replay_file != "" || m_driver->reordered_reads() != 0))
+            printf("AXI: reordered_reads=%u\n", m_driver->reordered_reads());
 
-        m_sequencer->start(50000);
-        m_sequencer->wait_complete();
+        // TLM only: simulated time is held in the driver
+        speed_report(m_tlm_only ? m_tlm_driver->local_time() : sc_time_stamp());
         sc_stop();
     }
 
     SC_HAS_PROCESS(testbench);
     testbench(sc_module_name name): testbench_vbase(name)
-    {    
+    {
+        m_replay_timed = true;
+        m_bench_ops    = 1000;
+        m_iterations   = 50000;
+        m_tlm_only     = false;
+        m_tlm_xcheck   = false;
+        m_rready_throttle = 0;
+        m_wdata_first  = false;
+        m_board_delay  = 0;
+        m_stream_period = 0;
+        m_xfer_bench   = false;
+
         m_driver = new tb_axi4_driver("DRIVER");
         m_driver->axi_out(axi_m);
         m_driver->axi_in(axi_s);
@@ -67,20 +529,104 @@ public:
         m_sequencer->clk_in(clk);
         m_sequencer->rst_in(rst);
 
+        m_replay = new tb_trace_replay("REPLAY", m_driver);
+        m_replay->clk_in(clk);
+        m_replay->rst_in(rst);
+
+        m_bench = new tb_mem_bench("BENCH", m_driver);
+        m_bench->clk_in(clk);
+        m_bench->rst_in(rst);
+
         m_dut = new sdram_axi("MEM");
         m_dut->clk_in(clk);
         m_dut->rst_in(rst);
+#ifdef SDRAM_AXI_ASYNC
+        m_dut->sdram_clk_in(clk_sdram);
+        m_dut->sdram_rst_in(rst_sdram);
+#endif
         m_dut->inport_in(axi_m);
         m_dut->inport_out(axi_s);
         m_dut->sdram_out(sdram_io_m);
         m_dut->sdram_in(sdram_io_s);
 
         m_mem = new tb_sdram_mem("TB_MEM");
+#ifdef SDRAM_AXI_ASYNC
+        m_mem->clk_in(clk_sdram);
+        m_mem->rst_in(rst_sdram);
+#else
         m_mem->clk_in(clk);
         m_mem->rst_in(rst);
+#endif
         m_mem->sdram_in(sdram_io_m);
         m_mem->sdram_out(sdram_io_s);
 
+#ifdef SDRAM_AXI_DUAL
+        m_dut->sdram1_out(sdram1_io_m);
+        m_dut->sdram1_in(sdram1_io_s);
+
+        m_mem1 = new tb_sdram_mem("TB_MEM1");
+        m_mem1->clk_in(clk);
+        m_mem1->rst_in(rst);
+        m_mem1->sdram_in(sdram1_io_m);
+        m_mem1->sdram_out(sdram1_io_s);
+
+        // Per-channel utilisation (SDRAM0: / SDRAM1: stats)
+        m_mem->set_channel(0);
+        m_mem1->set_channel(1);
+#endif
+
+#ifdef SDRAM_AXI_STREAM
+        m_dut->stream_start_in(stream_start);
+        m_dut->stream_addr_in(stream_addr);
+        m_dut->stream_len_in(stream_len);
+        m_dut->stream_ready_in(stream_ready);
+        m_dut->stream_valid_out(stream_valid);
+        m_dut->stream_data_out(stream_data);
+        m_dut->stream_busy_out(stream_busy);
+
+        m_stream = new tb_stream_consumer("STREAM");
+        m_stream->clk_in(clk);
+        m_stream->rst_in(rst);
+        m_stream->start_out(stream_start);
+        m_stream->addr_out(stream_addr);
+        m_stream->len_out(stream_len);
+        m_stream->ready_out(stream_ready);
+        m_stream->valid_in(stream_valid);
+        m_stream->data_in(stream_data);
+        m_stream->busy_in(stream_busy);
+#endif
+
+#ifdef SDRAM_AXI_XFER
+        m_dut->xfer_start_in(xfer_start);
+        m_dut->xfer_copy_in(xfer_copy);
+        m_dut->xfer_src_in(xfer_src);
+        m_dut->xfer_dst_in(xfer_dst);
+        m_dut->xfer_len_in(xfer_len);
+        m_dut->xfer_fill_data_in(xfer_fill_data);
+        m_dut->xfer_busy_out(xfer_busy);
+        m_dut->xfer_done_out(xfer_done);
+
+        m_xfer = new tb_xfer_bench("XFER", m_driver, m_mem);
+        m_xfer->clk_in(clk);
+        m_xfer->rst_in(rst);
+        m_xfer->start_out(xfer_start);
+        m_xfer->copy_out(xfer_copy);
+        m_xfer->src_out(xfer_src);
+        m_xfer->dst_out(xfer_dst);
+        m_xfer->len_out(xfer_len);
+        m_xfer->fill_out(xfer_fill_data);
+        m_xfer->busy_in(xfer_busy);
+        m_xfer->done_in(xfer_done);
+#endif
+
+        m_tlm = new sdram_axi_tlm("TLM", SDRAM_MHZ, SDRAM_ADDR_W, SDRAM_COL_W, SDRAM_READ_LATENCY);
+        m_tlm->model().configure(SDRAM_MHZ, SDRAM_ADDR_W, SDRAM_COL_W, SDRAM_READ_LATENCY, SDRAM_TRCD_NS, SDRAM_TRP_NS, SDRAM_TRFC_NS, SDRAM_BANK_W, SDRAM_RANK_W);
+
+        m_tlm_driver = new tb_tlm_driver("TLM_DRIVER");
+        m_tlm_driver->isock.bind(m_tlm->tsock);
+
+        m_xcheck = new tb_xcheck_driver(m_driver, m_tlm_driver);
+
         verilator_trace_enable("verilator.vcd", m_dut);
     }
 };
@@ -2,22 +2,32 @@
 #define TESTBENCH_VBASE_H
 
 #include <systemc.h>
+#include <sys/time.h>
 #include "verilated.h"
+
+#if VM_TRACE
+#if VM_TRACE_FST
+#include "verilated_fst_sc.h"
+typedef VerilatedFstSc tb_trace_file;
+#define TB_WAVES_EXT ".fst"
+#else
 #include "verilated_vcd_sc.h"
+typedef VerilatedVcdSc tb_trace_file;
+#define TB_WAVES_EXT ".vcd"
+#endif
 
+// Trace is registered up front, files are opened / closed by waves_control()
 #define verilator_trace_enable(vcd_filename, dut) \
         if (waves_enabled()) \
         { \
             Verilated::traceEverOn(true); \
-            VerilatedVcdSc *v_vcd = new VerilatedVcdSc; \
-            sc_core::sc_time delay_us; \
-            if (waves_delayed(delay_us)) \
-                dut->trace_enable (v_vcd, delay_us); \
-            else \
-                dut->trace_enable (v_vcd); \
-            v_vcd->open (vcd_filename); \
-            this->m_verilate_vcd = v_vcd; \
+            tb_trace_file *v_trace = new tb_trace_file; \
+            dut->trace_enable (v_trace); \
+            waves_setup(v_trace, vcd_filename); \
         }
+#else
+#define verilator_trace_enable(vcd_filename, dut)
+#endif
 
 //-----------------------------------------------------------------
 // Module
@@ -32,6 +42,7 @@ public:
     virtual void set_delays(bool en) { }
     virtual void set_iterations(int iterations) { }
     virtual void set_argcv(int argc, char* argv[]) { }
+    virtual void set_trace(bool en) { m_trace_enable = en; }
 
     virtual void process(void) { while (1) wait(); }
     virtual void monitor(void) { while (1) wait(); }
@@ -39,8 +50,17 @@ public:
     SC_HAS_PROCESS(testbench_vbase);
     testbench_vbase(sc_module_name name): sc_module(name)
     {    
+        m_trace_enable   = true;
+        m_waves_addr_size = 0;
+        m_waves_trigger  = SC_ZERO_TIME;
+#if VM_TRACE
+        m_trace_file     = NULL;
+#endif
         SC_CTHREAD(process, clk);
         SC_CTHREAD(monitor, clk);
+#if VM_TRACE
+        SC_CTHREAD(waves_control, clk);
+#endif
     }
 
     virtual void add_trace(sc_trace_file * fp, std::string prefix) { }
@@ -48,12 +68,40 @@ public:
     virtual void abort(void)
     {
         cout << "TB: Aborted at " << sc_time_stamp() << endl;
-        if (m_verilate_vcd)
+#if VM_TRACE
+        // Ring mode: the open segment plus the previous one hold the
+        // run up to the failure
+        if (m_trace_file && m_trace_file->isOpen())
         {
-            m_verilate_vcd->flush();
-            m_verilate_vcd->close();
-            m_verilate_vcd = NULL;
+            m_trace_file->flush();
+            m_trace_file->close();
+            printf("WAVES: Closed %s\n", m_waves_name.c_str());
         }
+        m_trace_file = NULL;
+#endif
+    }
+
+    //-----------------------------------------------------------------
+    // Simulation speed (simulated cycles per wall clock second)
+    //-----------------------------------------------------------------
+    double wall_time(void)
+    {
+        struct timeval tv;
+        gettimeofday(&tv, NULL);
+        return tv.tv_sec + (tv.tv_usec / 1000000.0);
+    }
+
+    void speed_start(void) { m_wall_start = wall_time(); m_sim_start = sc_time_stamp(); }
+
+    // end: Simulated end time (defaults to now)
+    void speed_report(sc_time end = sc_time_stamp())
+    {
+        double   wall   = wall_time() - m_wall_start;
+        sc_clock *c     = dynamic_cast<sc_clock *>(clk.get_interface());
+        double   cycles = c ? (end - m_sim_start) / c->period() : 0.0;
+
+        printf("SPEED: cycles=%.0f wall_s=%.3f cycles_per_sec=%.0f\n",
+                cycles, wall, wall > 0 ? cycles / wall : 0.0);
     }
 
     bool waves_enabled(void)
@@ -65,19 +113,123 @@ public:
             return true;
     }
 
-    bool waves_delayed(sc_core::sc_time &delay)
+    //-----------------------------------------------------------------
+    // Trace windows (env):
+    //  WAVES_DELAY_US     - Start tracing at this time
+    //  WAVES_END_US       - Stop tracing at this time
+    //  WAVES_RING_US      - Keep only the last 1-2 segments of this length
+    //                       (alternating _0/_1 files, closed on abort)
+    //  WAVES_ADDR         - Only trace around accesses to this address...
+    //  WAVES_ADDR_SIZE    - ...range (default 4 bytes)
+    //  WAVES_ADDR_US      - ...for this long after each hit (default 10uS)
+    //-----------------------------------------------------------------
+    sc_time getenv_us(const char *name, sc_time defval)
     {
-        char *s = getenv("WAVES_DELAY_US");
-        if (s != NULL)
+        char *s = getenv(name);
+        if (s && strcmp(s, ""))
+            return sc_time(strtoul(s, NULL, 0), SC_US);
+        else
+            return defval;
+    }
+
+#if VM_TRACE
+    void waves_setup(tb_trace_file *fp, std::string filename)
+    {
+        m_trace_file = fp;
+
+        // Base name, extension follows the compiled in format
+        size_t ext = filename.rfind('.');
+        m_waves_base = (ext != std::string::npos) ? filename.substr(0, ext) : filename;
+
+        m_waves_start = getenv_us("WAVES_DELAY_US", SC_ZERO_TIME);
+        m_waves_end   = getenv_us("WAVES_END_US",   SC_ZERO_TIME);
+        m_waves_ring  = getenv_us("WAVES_RING_US",  SC_ZERO_TIME);
+        m_waves_hold  = getenv_us("WAVES_ADDR_US",  sc_time(10, SC_US));
+
+        std::string addr = getenv_str("WAVES_ADDR", "");
+        if (addr != "")
         {
-            uint32_t us = strtoul(s, NULL, 0);
-            printf("WAVES: Delay start until %duS\n", us);
-            delay = sc_core::sc_time(us, SC_US);
-            return true;
+            m_waves_addr      = strtoul(addr.c_str(), NULL, 0);
+            m_waves_addr_size = strtoul(getenv_str("WAVES_ADDR_SIZE", "4").c_str(), NULL, 0);
         }
-        else
-            return false;
-    }    
+
+        if (m_waves_start != SC_ZERO_TIME)
+            printf("WAVES: Delay start until %.0fuS\n", m_waves_start / sc_time(1, SC_US));
+        if (m_waves_end != SC_ZERO_TIME)
+            printf("WAVES: Stop at %.0fuS\n", m_waves_end / sc_time(1, SC_US));
+        if (m_waves_ring != SC_ZERO_TIME)
+            printf("WAVES: Ring buffer, %.0fuS segments\n", m_waves_ring / sc_time(1, SC_US));
+        if (m_waves_addr_size)
+            printf("WAVES: Triggered by accesses to %08x-%08x\n", m_waves_addr, m_waves_addr + m_waves_addr_size - 1);
+    }
+
+    void waves_open(int idx)
+    {
+        char suffix[16] = "";
+        if (idx >= 0)
+            sprintf(suffix, "_%d", idx);
+
+        m_waves_name = m_waves_base + suffix + TB_WAVES_EXT;
+        m_trace_file->open(m_waves_name.c_str());
+    }
+
+    void waves_close(void)
+    {
+        m_trace_file->flush();
+        m_trace_file->close();
+    }
+
+    //-----------------------------------------------------------------
+    // waves_control: Open / close / rotate the trace file each cycle
+    //-----------------------------------------------------------------
+    void waves_control(void)
+    {
+        if (!m_trace_file || !m_trace_enable)
+            return;
+
+        sc_time segment_start = SC_ZERO_TIME;
+        int     segment       = 0;
+        int     window        = 0;
+
+        while (1)
+        {
+            sc_time t = sc_time_stamp();
+
+            bool active = (t >= m_waves_start) &&
+                          (m_waves_end == SC_ZERO_TIME || t < m_waves_end);
+            if (m_waves_addr_size)
+                active = active && (t < m_waves_trigger);
+
+            if (!m_trace_file)
+                return;
+            else if (active && !m_trace_file->isOpen())
+            {
+                // Address triggered windows each get their own file
+                waves_open(m_waves_ring != SC_ZERO_TIME ? segment : (m_waves_addr_size ? window++ : -1));
+                segment_start = t;
+            }
+            else if (!active && m_trace_file->isOpen())
+                waves_close();
+            else if (active && m_waves_ring != SC_ZERO_TIME && (t - segment_start) >= m_waves_ring)
+            {
+                waves_close();
+                segment = !segment;
+                waves_open(segment);
+                segment_start = t;
+            }
+
+            wait();
+        }
+    }
+#endif
+
+    // waves_address: Called on each access, opens a triggered window
+    void waves_address(uint32_t addr)
+    {
+        if (m_waves_addr_size && (addr - m_waves_addr) < m_waves_addr_size)
+            m_waves_trigger = sc_time_stamp() + m_waves_hold;
+    }
+    bool waves_triggered(void) { return m_waves_addr_size != 0; }
 
     std::string getenv_str(std::string name, std::string defval)
     {
@@ -89,7 +241,21 @@ public:
     }
 
 protected:
-    VerilatedVcdSc   *m_verilate_vcd;
+    bool              m_trace_enable;
+#if VM_TRACE
+    tb_trace_file    *m_trace_file;
+    std::string       m_waves_base;
+    std::string       m_waves_name;
+#endif
+    sc_time           m_waves_start;
+    sc_time           m_waves_end;
+    sc_time           m_waves_ring;
+    sc_time           m_waves_hold;
+    sc_time           m_waves_trigger;
+    uint32_t          m_waves_addr;
+    uint32_t          m_waves_addr_size;
+    double            m_wall_start;
+    sc_time           m_sim_start;
 };
 
 #endif
\ No newline at end of file